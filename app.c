@@ -3,7 +3,7 @@
  * @author 	Mohit Rathod
  * Created: 24 09 2022, 05:52:24 pm
  * -----
- * Last Modified: 21 07 2024, 08:36:04 am
+ * Last Modified: 19 10 2026, 12:56:49 am
  * Modified By  : Mohit Rathod
  * -----
  * MIT License
@@ -16,8 +16,12 @@
 #include <mos.h>
 #include <utils/errmos.h>
 #include <utils/icsserver.h>
+#if MOS_USES(ICS_SLIP)
+#include <utils/icsslip.h>
+#endif
 #include <utils/smf.h>
 #include <dev/md13s.h>
+#include "sunroof.h"
 
 
 // Service functions
@@ -25,6 +29,10 @@ uint8_t srvc_port0(void *pargs);
 uint8_t srvc_port1(void *pargs);
 uint8_t srvc_port2(void *pargs);
 
+// Register getters
+static void reg_state(uint8_t *pDst);
+static void reg_ticks(uint8_t *pDst);
+
 uint8_t var_p1[1];
 uint8_t var_p2[1];
 
@@ -33,104 +41,69 @@ uint8_t var_p2[1];
 /* Debounce period register value to be fed to TACCRx */
 const uint16_t debounce_period = ((((MOS_GET(MCLK_FREQ) * 1000)/4)*DEBOUNCE_TIME_MS) - 1);
 
-/* Map sunroof events to StateMachine */
-#define EV_OPEN       EVENT_0
-#define EV_CLOSE      EVENT_1
-#define EV_STOP       EVENT_2
-#define EV_FSM_RST    EVENT_3
-#define EV_LIMIT      EVENT_4
-
-/* Map sunroof states to StateMachine */
-#define ST_OPEN       STATE_0
-#define ST_OPENING    STATE_1
-#define ST_CLOSE      STATE_2
-#define ST_CLOSING    STATE_3
-#define ST_STOPPED    STATE_4
+/* Sunroof state machine instance */
+static smf_t sunroof;
 
-state_t openEvent_Handler(void)
-state_t closeEvent_Handler(void)
-state_t stopEvent_Handler(void)
-state_t limit_openEvent_Handler(void)
-state_t limit_closeEvent_Handler(void)
-state_t resetEvent_Handler(void)
+/* Registers the fleet master polls in one read */
+static const icsReg_t regMap[] = {
+    { 0x00, 1, ICS_REG_RD, NULL, reg_state },   /* sunroof state */
+    { 0x01, 2, ICS_REG_RD, NULL, reg_ticks }    /* mOSS ticks, LSB first */
+};
 
 
 void setup()
 {
     errmos = ICSserver_init();
     EPRINT("\nI2C server initialization");
+    errmos = ICSi2c_init();
+    EPRINT("\nI2C transport of ICS server.");
     errmos = ICS_addService(srvc_port0, 0, NULL, PORT_0);
     EPRINT("\nAdding service to port 0 of ICS server.");
     errmos = ICS_addService(srvc_port1, 1, var_p1, PORT_1);
     EPRINT("\nAdding service to port 1 of ICS server.");
     errmos = ICS_addService(srvc_port2, 1, var_p2, PORT_2);
     EPRINT("\nAdding service to port 2 of ICS server.");
-
-    /* event action pair for ST_OPEN case */
-    evAction_t eAST_Open[] = {
-                                  {EV_CLOSE, closeEvent_Handler},
-                                  {EV_STOP, stopEvent_Handler}
-                                };
-
-    /* event action pair for ST_CLOSE case */
-    evAction_t eAST_Close[] =  {
-                                    {EV_OPEN, openEvent_Handler},
-                                    {EV_STOP, stopEvent_Handler}
-                                  };
-    
-    /* event action pair for ST_OPENING case */
-    evAction_t eAST_Opening[] ={
-                                    {EV_LIMIT, limit_openEvent_Handler},
-                                    {EV_CLOSE, closeEvent_Handler},
-                                    {EV_STOP, stopEvent_Handler}
-                                  };
-    
-    /* event action pair for ST_CLOSING case */
-    evAction_t eAST_Closing[] ={
-                                    {EV_LIMIT, limit_closeEvent_Handler},
-                                    {EV_OPEN, openEvent_Handler},
-                                    {EV_STOP, stopEvent_Handler}
-                                  };
-    
-    /* event action pair for ST_STOPPED case */
-    evAction_t eAST_Stopped[] ={ {EV_FSM_RST, resetEvent_Handler} };
-
-    errmos = SMF_init(ST_CLOSE);
+#if MOS_USES(SMF_TRACE)
+    errmos = SMF_traceInit(PORT_3);
+    EPRINT("\nAdding SMF trace to port 3 of ICS server.");
+#endif
+    errmos = ICS_setRegMap(regMap, ARRAY_SIZE(regMap));
+    EPRINT("\nAdding register map to ICS server.");
+#if MOS_USES(ICS_SLIP)
+    errmos = ICSslip_init();
+    EPRINT("\nSLIP transport of ICS server.");
+#endif
+
+    errmos = SMF_init(&sunroof, &sunroofTable, SUNROOF_INIT_STATE, NULL);
     EPRINT("\nState Machine Initialization");
+#if MOS_USES(SMF_COALESCE)
+    /* a chatty host can't fill the queue with open/close commands */
+    errmos = SMF_setCoalesce(&sunroof, SMF_COALESCE_REPLACE_CLASS,
+                                                    sunroofEventClass);
+    EPRINT("\nState Machine event coalescing");
+#endif
 
-    errmos = SMF_addState(ST_CLOSE, eAST_Close, ARRAY_SIZE(eAST_Close));
-    EPRINT("\nAdding ST_CLOSE to SMF");
-    
-    errmos = SMF_addState(ST_OPEN, eAST_Open, ARRAY_SIZE(eAST_Open));
-    EPRINT("\nAdding ST_OPEN to SMF");
-    
-    errmos = SMF_addState(ST_OPENING, eAST_Opening, ARRAY_SIZE(eAST_Opening));
-    EPRINT("\nAdding ST_OPENING to SMF");
-
-    errmos = SMF_addState(ST_CLOSING, eAST_Closing, ARRAY_SIZE(eAST_Closing));
-    EPRINT("\nAdding ST_CLOSING to SMF");
-    
-    errmos = SMF_addState(ST_STOPPED, eAST_Stopped, ARRAY_SIZE(eAST_Stopped));
-    EPRINT("\nAdding ST_STOPPED to SMF");
-    
     mossAddTask(SMF_Run, 20, 50);
 }
 
 void loop()
 {
+#if MOS_USES(ICS_SLIP)
+    ICSslip_run();
+#endif
     ICS_run();
 }
 
 uint8_t srvc_port0(void *pargs)
 {
     (void) pargs;
-    return SMF_getState();
+    return SMF_getState(&sunroof);
 }
 
 uint8_t srvc_port1(void *pargs)
 {
     uint8_t *args = (uint8_t*)pargs;
-    return (uint8_t)SMF_putEvent(args);
+    return (uint8_t)SMF_putEvent(&sunroof, args);
 }
 
 uint8_t srvc_port2(void *pargs)
@@ -140,45 +113,16 @@ uint8_t srvc_port2(void *pargs)
     return 0;
 }
 
-state_t openEvent_Handler(void)
-{
-  md13s_run(MD_CW);
-  MPRINT("\nOpen Event Handler.");
-  return ST_OPENING;
-}
-
-state_t closeEvent_Handler(void)
-{
-  md13s_run(MD_CCW);
-  MPRINT("\nClose Event Handler.");
-  return ST_CLOSING;
-}
-
-state_t stopEvent_Handler(void)
-{
-  md13s_stop();
-  MPRINT("\nStop Event Handler.");
-  return ST_STOPPED;
-}
-
-state_t limit_openEvent_Handler(void)
-{
-  md13s_stop();
-  MPRINT("\nLimit(o)Event Handler.");
-  return ST_OPEN;
-}
-
-state_t limit_closeEvent_Handler(void)
+static void reg_state(uint8_t *pDst)
 {
-  md13s_stop();
-  MPRINT("\nLimit(c)Event Handler.");
-  return ST_CLOSE;
+    pDst[0] = SMF_getState(&sunroof);
 }
 
-state_t resetEvent_Handler(void)
+static void reg_ticks(uint8_t *pDst)
 {
-  MPRINT("\nReset Event Handler.");
-  return ST_CLOSE;
+    uint16_t ticks = mossTicks();
+    pDst[0] = (uint8_t)ticks;
+    pDst[1] = (uint8_t)(ticks >> 8);
 }
 
 /**
@@ -223,7 +167,7 @@ __attribute__ ((interrupt(TIMER0_A1_VECTOR))) void Timer0A1_ISR(void)
             {
               /* Push a reset event on the SM queue */
                 evnt = EV_FSM_RST;
-                SMF_putEvent(&evnt);
+                SMF_putEvent(&sunroof, &evnt);
             }
             P1IFG &= ~(BIT3);
             P1IE |= BIT3;
@@ -236,7 +180,7 @@ __attribute__ ((interrupt(TIMER0_A1_VECTOR))) void Timer0A1_ISR(void)
             {
                 /* Push a limits event on the SM queue */
                 evnt = EV_LIMIT;
-                SMF_putEvent(&evnt);
+                SMF_putEvent(&sunroof, &evnt);
             }
             P1IFG &= ~(BIT4);
             P1IE |= BIT4;
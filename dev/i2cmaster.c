@@ -0,0 +1,192 @@
+/** 
+ * @file 	i2cmaster.c
+ * @author 	Mohit Rathod
+ * Created: 19 10 2026, 12:25:18 am
+ * -----
+ * Last Modified: 19 10 2026, 01:01:28 am
+ * Modified By  : Mohit Rathod
+ * -----
+ * MIT License
+ * https://opensource.org/licenses/MIT
+ * 
+ * @brief   I2C Master driver APIs
+ * 
+ */
+#include <mosconfig.h>
+#include <stddef.h>
+#include <mcu.h>
+#include "i2cmaster.h"
+#include "usci.h"
+
+/* If invalid speed configured revert to default value */
+#if (MOS_GET(I2C_SPEED) != 100000) && (MOS_GET(I2C_SPEED) != 400000)
+#undef MOS_I2C_SPEED
+#define MOS_I2C_SPEED           (100000)
+#if MOS_USES(I2C) == 1
+#warning "Invalid I2C speed, reverting to default speed(100 kbps)."
+#endif
+#endif
+
+/* SCL divider, SMCLK runs at MCLK */
+#define I2C_BR                  ((MOS_GET(MCLK_FREQ) * 1000000UL) / MOS_GET(I2C_SPEED))
+
+/* Bus phase of the active transaction */
+enum
+{
+    PHASE_IDLE = 0,         /* bus free, queue empty */
+    PHASE_DATA,             /* bytes moved by the Tx/Rx handler */
+    PHASE_ADDR,             /* address out, i2cmaster_poll waits on UCTXSTT */
+    PHASE_STOP              /* STOP queued, i2cmaster_poll waits on UCTXSTP */
+};
+
+static i2cXfer_t *_queue[I2C_QUEUE_LEN];
+static volatile uint8_t _head;          /* transactions submitted */
+static volatile uint8_t _tail;          /* transactions completed */
+static volatile uint8_t _phase;         /* PHASE_x */
+static volatile uint8_t _active;        /* the one at _tail is on the bus */
+static uint8_t _txIdx;                  /* bytes of the active one written */
+static uint8_t _rxIdx;                  /* and read */
+
+static void i2cmaster_start(void);
+static void i2cmaster_read(const i2cXfer_t *pXfer);
+static void i2cmaster_finish(int8_t status);
+static void i2cmaster_dataHandler(void);
+static void i2cmaster_stateHandler(void);
+
+int i2cmaster_init()
+{
+    if ((usci_register(USCI_VEC_TX, i2cmaster_dataHandler, USCI_PRIO_I2C) != 0) ||
+        (usci_register(USCI_VEC_RX, i2cmaster_stateHandler, USCI_PRIO_I2C) != 0)) {
+        return -1;
+    }
+    /* Configure the USCI_B module */
+    UCB0CTL1 |= UCSWRST;                // Enable SW reset
+    UCB0CTL0 = UCMST + UCMODE_3 + UCSYNC; // I2C Master, synchronous mode
+    UCB0CTL1 = UCSSEL_2 + UCSWRST;      // SMCLK, keep SW reset
+    UCB0BR0 = (uint8_t)I2C_BR;          // SCL = SMCLK / I2C_BR
+    UCB0BR1 = (uint8_t)(I2C_BR >> 8);
+    UCB0CTL1 &= ~UCSWRST;               // Clear SW rst, resume operation
+    UCB0I2CIE = UCNACKIE + UCALIE;      // Enable NACK/AL interrupt
+    _head = 0;
+    _tail = 0;
+    _phase = PHASE_IDLE;
+    _active = 0;
+    return 0;
+}
+
+int i2cmaster_submit(i2cXfer_t *pXfer)
+{
+    int ret = -1;
+    const unsigned short sr = __get_interrupt_state();
+    if ((pXfer != NULL) && ((pXfer->pTx != NULL) || (pXfer->txLen == 0)) &&
+        ((pXfer->pRx != NULL) || (pXfer->rxLen == 0))) {
+        /* the ISR may complete the active transaction meanwhile */
+        __disable_interrupt();
+        if ((uint8_t)(_head - _tail) < I2C_QUEUE_LEN) {
+            pXfer->status = I2C_PENDING;
+            _queue[_head++ & (I2C_QUEUE_LEN - 1)] = pXfer;
+            /* bus idle, start it, else i2cmaster_poll does after the
+             * STOP of the one before */
+            if (_phase == PHASE_IDLE) {
+                i2cmaster_start();
+            }
+            ret = 0;
+        }
+        __set_interrupt_state(sr);
+    }
+    return ret;
+}
+
+int i2cmaster_pending()
+{
+    return (uint8_t)(_head - _tail);
+}
+
+void i2cmaster_poll()
+{
+    /* from the tick ISR, the USCI handlers don't run meanwhile; a
+     * NACK pending is left to the state handler */
+    if ((_phase != PHASE_IDLE) && !(UCB0STAT & UCNACKIFG)) {
+        if ((_phase == PHASE_ADDR) && !(UCB0CTL1 & UCTXSTT)) {
+            /* address ACKed: the only byte of a read is coming in, the
+             * STOP follows it (SLAU144 17.3.4.2.2) */
+            UCB0CTL1 |= UCTXSTP;
+            _phase = PHASE_STOP;
+        }
+        /* STOP out and the last byte read, the bus is free */
+        else if ((_phase == PHASE_STOP) && !(UCB0CTL1 & UCTXSTP) &&
+                 !(IFG2 & UCB0RXIFG)) {
+            IE2 &= ~(UCB0TXIE + UCB0RXIE);
+            /* a write or probe completes once the STOP follows the ACK
+             * of its last byte or address, a callback submitting
+             * meanwhile only queues */
+            if (_active) {
+                i2cmaster_finish(I2C_DONE);
+            }
+            _phase = PHASE_IDLE;
+            if (_head != _tail) {
+                i2cmaster_start();
+            }
+        }
+    }
+}
+
+/**
+ * @brief   Start the transaction at the tail of the queue, the bus is
+ *          free.
+ */
+static void i2cmaster_start(void)
+{
+    const i2cXfer_t *pXfer = _queue[_tail & (I2C_QUEUE_LEN - 1)];
+    _txIdx = 0;
+    _rxIdx = 0;
+    _active = 1;
+    UCB0STAT &= ~UCNACKIFG;
+    UCB0I2CSA = pXfer->addr;
+    if (pXfer->txLen != 0) {
+        /* write, a read follows with a repeated START */
+        _phase = PHASE_DATA;
+        IE2 = (IE2 & ~UCB0RXIE) | UCB0TXIE;
+        UCB0CTL1 |= UCTR + UCTXSTT;
+    }
+    else if (pXfer->rxLen == 0) {
+        /* probe, the STOP goes out right after the address, a NACK
+         * of it still raises the state interrupt */
+        _phase = PHASE_STOP;
+        IE2 &= ~(UCB0TXIE + UCB0RXIE);
+        UCB0CTL1 |= UCTR + UCTXSTT + UCTXSTP;
+    }
+    else {
+        i2cmaster_read(pXfer);
+    }
+}
+
+/**
+ * @brief   (Repeated) START of the read part of a transaction.
+ */
+static void i2cmaster_read(const i2cXfer_t *pXfer)
+{
+    /* the STOP of a one-byte read is set once the address is ACKed,
+     * i2cmaster_poll watches for it */
+    _phase = (pXfer->rxLen == 1) ? PHASE_ADDR : PHASE_DATA;
+    IE2 = (IE2 & ~UCB0TXIE) | UCB0RXIE;
+    UCB0CTL1 &= ~UCTR;
+    UCB0CTL1 |= UCTXSTT;
+}
+
+/**
+ * @brief   Complete the active transaction, always from an interrupt.
+ *          The next one starts from i2cmaster_poll once the bus is free.
+ */
+static void i2cmaster_finish(int8_t status)
+{
+    i2cXfer_t *pXfer = _queue[_tail & (I2C_QUEUE_LEN - 1)];
+    _active = 0;
+    _tail++;
+    pXfer->status = status;
+    if (pXfer->done != NULL) {
+        pXfer->done(pXfer);
+    }
+}
+
+#include <dev/i2cmasterISR.h>
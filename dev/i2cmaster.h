@@ -0,0 +1,124 @@
+/** 
+ * @file 	i2cmaster.h
+ * @author 	Mohit Rathod
+ * Created: 19 10 2026, 12:25:18 am
+ * -----
+ * Last Modified: 19 10 2026, 01:01:28 am
+ * Modified By  : Mohit Rathod
+ * -----
+ * MIT License
+ * https://opensource.org/licenses/MIT
+ * 
+ * @brief   I2C master driver. Runs queued transactions on the USCI_B
+ *          module from its interrupts, at MOS_I2C_SPEED, without
+ *          waiting on the bus.
+ * -------------------------------------------------------------------  
+ *                 Master
+ *              MSP430G2553
+ *          -----------------
+ *      /|\|              XIN|-
+ *       | |                 |
+ *       --|RST          XOUT|-
+ *         |                 |
+ *         |                 |
+ *         |                 |
+ *         |         SDA/P1.7|<------>
+ *         |         SCL/P1.6|------->
+ * 
+ * Note: External pull-ups are needed for SDA & SCL
+ * -------------------------------------------------------------------
+ * 
+ *  A transaction writes txLen bytes, then reads rxLen bytes after a
+ *  repeated START:
+ *      txLen > 0, rxLen = 0    => write
+ *      txLen = 0, rxLen > 0    => read
+ *      txLen > 0, rxLen > 0    => write-then-read (eg register read)
+ *      txLen = 0, rxLen = 0    => address probe
+ * 
+ *  A write or probe completes once the STOP is out, after the ACK of
+ *  its last byte, so a NACK of any byte or of the address is reported.
+ * 
+ *  The USCI has no interrupt for an address ACK nor for the end of a
+ *  STOP, those phases are polled by i2cmaster_poll from the mOSS tick
+ *  interrupt (mossch.c): the STOP of a one-byte read, the completion
+ *  of a write or probe and the start of the next transaction. So every
+ *  transaction completes in an interrupt, whatever the main loop does,
+ *  and nothing waits in one. A write or probe completes, and the next
+ *  transaction starts, on the first tick after its STOP (up to
+ *  MOSS_TICK_MS). A one-byte read whose address phase ends before a
+ *  tick sees it clocks in one more byte, which is dropped.
+ * 
+ */
+#ifndef dev_i2c_master_h
+#define dev_i2c_master_h
+#include <stdint.h>
+#include <mosconfig.h>
+
+/* Transactions queued ahead of the bus (a power of 2) */
+#if MOS_GET(I2C_QUEUE)
+#define I2C_QUEUE_LEN           MOS_GET(I2C_QUEUE)
+#else
+#define I2C_QUEUE_LEN           (4)
+#endif
+
+/* Transaction status */
+#define I2C_DONE                (0)     /* completed */
+#define I2C_PENDING             (1)     /* queued or on the bus */
+#define I2C_NACK                (-1)    /* address or data byte NACKed */
+#define I2C_ARB_LOST            (-2)    /* another master won the bus */
+
+/**
+ * @brief   I2C transaction. Owned by the caller, it must stay valid
+ *          until its status leaves I2C_PENDING.
+ */
+typedef struct i2cXfer
+{
+    uint8_t addr;                       /* 7 bit slave address */
+    uint8_t txLen;                      /* bytes to write */
+    uint8_t rxLen;                      /* bytes to read */
+    const uint8_t *pTx;                 /* bytes written */
+    uint8_t *pRx;                       /* buffer the bytes are read to */
+    void (*done)(struct i2cXfer *pXfer);/* completion, or NULL */
+    volatile int8_t status;             /* I2C_PENDING until completed */
+} i2cXfer_t;
+
+/**
+ * @fn      int i2cmaster_init(void);
+ * @brief   Initialize the USCI module for I2C master operation.
+ * @param   void
+ * @return  0 on success, -1 otherwise
+ */
+int i2cmaster_init(void);
+
+/**
+ * @fn      int i2cmaster_submit(i2cXfer_t *pXfer);
+ * @brief   Queue a transaction. It starts right away if the bus is
+ *          idle, the rest runs from the USCI and tick interrupts.
+ * @param   pXfer   the transaction, its status is set to I2C_PENDING.
+ * @return  0 on success, -1 if the queue is full or pXfer invalid.
+ * @note    The completion is the done callback, called from the USCI
+ *          or tick ISR once the status is set. Without one, a task
+ *          polls the status (eg a mOSS task checking it every tick).
+ *          May be called from a done callback to chain transactions.
+ */
+int i2cmaster_submit(i2cXfer_t *pXfer);
+
+/**
+ * @fn      void i2cmaster_poll(void);
+ * @brief   Move the bus phases without an interrupt on: complete a
+ *          write or probe once its STOP is out, start the next queued
+ *          transaction. Called from the mOSS tick ISR.
+ * @param   void
+ * @return  void
+ */
+void i2cmaster_poll(void);
+
+/**
+ * @fn      int i2cmaster_pending(void);
+ * @brief   Number of transactions queued or on the bus.
+ * @param   void
+ * @return  transaction count.
+ */
+int i2cmaster_pending(void);
+
+#endif /* dev_i2c_master_h */
@@ -0,0 +1,88 @@
+/** 
+ * @file 	i2cmasterISR.h
+ * @author 	Mohit Rathod
+ * Created: 19 10 2026, 12:25:18 am
+ * -----
+ * Last Modified: 19 10 2026, 01:01:28 am
+ * Modified By  : Mohit Rathod
+ * -----
+ * MIT License
+ * https://opensource.org/licenses/MIT
+ * 
+ * @brief   Handlers of the I2C master driver, registered on the
+ *          USCI vectors (@see usci.h).
+ * 
+ */
+
+/* Tx and Rx handler */
+static void i2cmaster_dataHandler(void)
+{
+    const i2cXfer_t *pXfer = _queue[_tail & (I2C_QUEUE_LEN - 1)];
+    uint8_t c;
+    /* I2C Tx ISR */
+    if ((IE2 & UCB0TXIE) && (IFG2 & UCB0TXIFG)) {
+        if (_txIdx < pXfer->txLen) {
+            UCB0TXBUF = pXfer->pTx[_txIdx++];
+        }
+        else if (pXfer->rxLen != 0) {
+            /* repeated START for the read */
+            IFG2 &= ~UCB0TXIFG;
+            i2cmaster_read(pXfer);
+        }
+        else {
+            /* last byte in the shift register, the STOP follows its
+             * ACK, i2cmaster_poll completes the write then */
+            IE2 &= ~UCB0TXIE;
+            UCB0CTL1 |= UCTXSTP;
+            _phase = PHASE_STOP;
+        }
+    }
+    /* I2C Rx ISR */
+    else if ((IE2 & UCB0RXIE) && (IFG2 & UCB0RXIFG)) {
+        c = UCB0RXBUF;
+        /* else the byte after a late one-byte STOP, dropped */
+        if (_active) {
+            pXfer->pRx[_rxIdx++] = c;
+            if (_rxIdx == pXfer->rxLen) {
+                /* i2cmaster_poll missed the address phase of a one-byte
+                 * read, one more byte is clocked in */
+                if (_phase != PHASE_STOP) {
+                    UCB0CTL1 |= UCTXSTP;
+                    _phase = PHASE_STOP;
+                }
+                i2cmaster_finish(I2C_DONE);
+            }
+            /* the STOP goes out after the byte now coming in */
+            else if ((uint8_t)(pXfer->rxLen - _rxIdx) == 1) {
+                UCB0CTL1 |= UCTXSTP;
+                _phase = PHASE_STOP;
+            }
+        }
+    }
+}
+
+/* NACK/arbitration lost handler */
+static void i2cmaster_stateHandler(void)
+{
+    /* I2C state ISR */
+    if (UCB0STAT & UCNACKIFG) {
+        /* the address or a byte written, the last one included */
+        UCB0STAT &= ~UCNACKIFG;
+        if (_active) {
+            IE2 &= ~(UCB0TXIE + UCB0RXIE);
+            UCB0CTL1 |= UCTXSTP;
+            _phase = PHASE_STOP;
+            i2cmaster_finish(I2C_NACK);
+        }
+    }
+    else if (UCB0STAT & UCALIFG) {
+        /* the USCI dropped to slave mode, back to master */
+        UCB0STAT &= ~UCALIFG;
+        UCB0CTL0 |= UCMST;
+        if (_active) {
+            IE2 &= ~(UCB0TXIE + UCB0RXIE);
+            _phase = PHASE_STOP;
+            i2cmaster_finish(I2C_ARB_LOST);
+        }
+    }
+}
@@ -3,7 +3,7 @@
  * @author 	Mohit Rathod
  * Created: 23 09 2022, 11:00:46 pm
  * -----
- * Last Modified: 23 09 2022, 11:15:00 pm
+ * Last Modified: 19 10 2026, 12:44:08 am
  * Modified By  : Mohit Rathod
  * -----
  * MIT License
@@ -15,12 +15,16 @@
 #include <mosconfig.h>
 #include <mcu.h>
 #include "i2cslave.h"
+#include "usci.h"
 
 void (*_receive_callback)(const uint8_t receive);
 void (*_transmit_callback)(volatile uint8_t *send_next);
 void (*_state_callback)(void);
 
-void i2cslave_init(void (*State_Callback)(),
+static void i2cslave_dataHandler(void);
+static void i2cslave_stateHandler(void);
+
+int i2cslave_init(void (*State_Callback)(),
                    void (*Tx_Callback)(volatile uint8_t *value),
 				   void (*Rx_Callback)(const uint8_t value),
 				   uint8_t slave_address)
@@ -29,6 +33,10 @@ void i2cslave_init(void (*State_Callback)(),
     _state_callback = State_Callback;
     _receive_callback = Rx_Callback;
     _transmit_callback = Tx_Callback;
+    if ((usci_register(USCI_VEC_TX, i2cslave_dataHandler, USCI_PRIO_I2C) != 0) ||
+        (usci_register(USCI_VEC_RX, i2cslave_stateHandler, USCI_PRIO_I2C) != 0)) {
+        return -1;
+    }
     /* Configure the USCI_B module */
     UCB0CTL1 |= UCSWRST;                // Enable SW reset
 	UCB0CTL0 = UCMODE_3 + UCSYNC;       // I2C Slave, synchronous mode
@@ -36,8 +44,19 @@ void i2cslave_init(void (*State_Callback)(),
 	UCB0CTL1 &= ~UCSWRST;               // Clear SW rst, resume operation
 	IE2 |= UCB0TXIE + UCB0RXIE;         // Enable RX/TX interrupt
 	UCB0I2CIE |= UCSTPIE + UCSTTIE;     // Enable STT/STP interrupt
+    return 0;
+}
+
+void i2cslave_nack()
+{
+    /* cleared by the USCI once the NACK is sent */
+    UCB0CTL1 |= UCTXNACK;
+}
+
+int i2cslave_isStop()
+{
+    /* the State handler clears the flag after the callback */
+    return (UCB0STAT & UCSTPIFG) ? 1 : 0;
 }
 
-#if MOS_USES(I2C) == 2
 #include <dev/i2cslaveISR.h>
-#endif
@@ -3,7 +3,7 @@
  * @author 	Mohit Rathod
  * Created: 23 09 2022, 10:52:32 pm
  * -----
- * Last Modified: 23 09 2022, 10:59:43 pm
+ * Last Modified: 19 10 2026, 12:44:08 am
  * Modified By  : Mohit Rathod
  * -----
  * MIT License
@@ -39,11 +39,28 @@
  * @param   Tx_Callback     Callback fn for byte requested by Master
  * @param   Rx_Callback     Callback fn for byte received from Master
  * @param   slave_address   Own address for slave mode
- * @return  void
+ * @return  0 on success, -1 if a USCI handler could not be registered
  */
-void i2cslave_init(void (*State_Callback)(),
+int i2cslave_init(void (*State_Callback)(),
                    void (*Tx_Callback)(volatile uint8_t *value),
 				   void (*Rx_Callback)(const uint8_t value),
 				   uint8_t slave_address);
 
+/**
+ * @brief   Refuse the next byte written by the master, it is answered
+ *          with a NACK instead of an ACK. To be called from the Rx
+ *          callback, the byte being handled there is already ACKed.
+ * @param   void
+ * @return  void
+ */
+void i2cslave_nack(void);
+
+/**
+ * @brief   Condition the State callback is running for.
+ * @param   void
+ * @return  1 for a STOP, 0 for a START or repeated START. Valid in the
+ *          State callback only.
+ */
+int i2cslave_isStop(void);
+
 #endif /* dev_i2c_slave_h */
\ No newline at end of file
@@ -3,25 +3,19 @@
  * @author 	Mohit Rathod
  * Created: 23 09 2022, 11:10:46 pm
  * -----
- * Last Modified: 23 09 2022, 11:14:33 pm
+ * Last Modified: 19 10 2026, 12:20:49 am
  * Modified By  : Mohit Rathod
  * -----
  * MIT License
  * https://opensource.org/licenses/MIT
  * 
- * @brief   ISR for I2C slave driver. This ISR also handles the
- *          UART interrupts to avoid conflict with Serial Driver
- *          when both modules are used simultaneously.
+ * @brief   Handlers of the I2C slave driver, registered on the
+ *          USCI vectors (@see usci.h).
  * 
  */
 
-#if MOS_USES(UART) == 1
-#include <utils/queue.h>
-extern qid_t serial_qID;
-#endif
-
-/* Tx and Rx interrupt service routine */
-__attribute__((interrupt(USCIAB0TX_VECTOR))) void USCIAB0TX_ISR(void)
+/* Tx and Rx handler */
+static void i2cslave_dataHandler(void)
 {
     /* I2C Tx ISR */
     if(IFG2 & UCB0TXIFG)
@@ -35,20 +29,9 @@ __attribute__((interrupt(USCIAB0TX_VECTOR))) void USCIAB0TX_ISR(void)
     }
 }
 
-/* Conflict with UART ISR.......... */
-/* Start and Stop interrupt service routine */
-__attribute__((interrupt(USCIAB0RX_VECTOR))) void USCIAB0RX_ISR(void)
+/* Start and Stop handler */
+static void i2cslave_stateHandler(void)
 {
-    /* UART ISR */
-    #if MOS_USES(UART) == 1
-    if (IFG2 & UCA0RXIFG)
-    {
-        const char c = UCA0RXBUF;
-        /* Clear the interrupt flag */
-        IFG2 &= ~UCA0RXIFG;
-        qEnqueue(serial_qID, &c);
-    }
-    #endif
     /* I2C state ISR */
     if (UCB0STAT & UCSTPIFG)            //Stop Interrupt
 	{
@@ -3,7 +3,7 @@
  * @author 	Mohit Rathod
  * Created: 21 09 2022, 04:22:37 pm
  * -----
- * Last Modified: 18 07 2024, 02:45:49 pm
+ * Last Modified: 19 10 2026, 01:02:12 am
  * Modified By  : Mohit Rathod
  * -----
  * MIT License
@@ -17,15 +17,27 @@
 #include <mcu.h>
 #include "serial.h"
 #include "serialconfig.h"
+#include "usci.h"
 
 static const size_t SERIAL_BAUD = MOS_GET(UART_BAUD)/100;
 
+/* Tx ring, filled by the writes and drained by the Tx interrupt */
+static uint8_t serial_txMEM[SERIAL_TX_RING];
+static volatile uint8_t serial_txHead;
+static volatile uint8_t serial_txTail;
+
+static void serial_txHandler(void);
+static size_t serial_txAccept(size_t len);
+static void serial_txPut(uint8_t c);
+static void serial_txPoll(void);
+
 /* Serial Tx only mode omits this. */
 #if SERIAL_LITE != 1
 #include <utils/queue.h>
 extern qid_t serial_qID;
 static char serial_qMEM[SERIAL_QUEUE_LEN];
 qid_t serial_qID = -1;
+static void serial_rxHandler(void);
 #endif /* SERIAL_LITE */
 
 int serial_init()
@@ -38,15 +50,21 @@ int serial_init()
         UCA0BR0 = UCBR0_UART;
         UCA0BR1 = UCBR1_UART;
         UCA0MCTL = UCBRS_UART;
+        serial_txHead = 0;
+        serial_txTail = 0;
 #if SERIAL_LITE == 1
-        /* Enable the USCI peripheral (take it out of reset) */
-        UCA0CTL1 &= ~UCSWRST;
-        ret = 0;
+        if (usci_register(USCI_VEC_TX, serial_txHandler, USCI_PRIO_UART_TX) == 0) {
+            /* Enable the USCI peripheral (take it out of reset) */
+            UCA0CTL1 &= ~UCSWRST;
+            ret = 0;
+        }
 #else
         q_attr_t attr = {sizeof(serial_qMEM[0]), ARRAY_SIZE(serial_qMEM),
                                 serial_qMEM};
         /* Initialize the UART queue */
-        if (q_init(&serial_qID, &attr) == 0) 
+        if ((q_init(&serial_qID, &attr) == 0) &&
+            (usci_register(USCI_VEC_RX, serial_rxHandler, USCI_PRIO_UART_RX) == 0) &&
+            (usci_register(USCI_VEC_TX, serial_txHandler, USCI_PRIO_UART_TX) == 0))
         {
             /* Enable the USCI peripheral (take it out of reset) */
             UCA0CTL1 &= ~UCSWRST;
@@ -73,35 +91,62 @@ int serial_getchar(uint8_t *p)
 
 int serial_putchar(int c)
 {
-    /* Wait for the transmit buffer to be ready. */
-    while (!(IFG2 & UCA0TXIFG));
-    /* Transmit data */
-    UCA0TXBUF = (char) c;
-    return 0;
+    const uint8_t b = (uint8_t)c;
+    return (serial_send(&b, 1) == 1) ? 0 : -1;
 }
 
 int serial_write(const char *str)
 {
     int ret = -1;
+    const char *p;
+    size_t len = 0;
     if (str != NULL) {
-        ret = 0;
-        while (*str != '\0') {
-            /* Wait for the transmit buffer to be ready */
-            while (!(IFG2 & UCA0TXIFG));
-            /* Transmit data */
-            UCA0TXBUF = *str;
-            /*  If there is a line-feed, add a carriage return */
-            if (*str == '\n') {
-                /* Wait for the transmit buffer to be ready */
-                while (!(IFG2 & UCA0TXIFG));
-                UCA0TXBUF = '\r';
+        /*  a line-feed is followed by a carriage return */
+        for (p = str; *p != '\0'; p++) {
+            len += (*p == '\n') ? 2 : 1;
         }
-        str++;
+        len = serial_txAccept(len);
+        while ((*str != '\0') && (len >= ((*str == '\n') ? 2 : 1))) {
+            serial_txPut(*str);
+            len--;
+            if (*str == '\n') {
+                serial_txPut('\r');
+                len--;
+            }
+            str++;
         }
+        ret = (*str == '\0') ? 0 : -1;
     }
     return ret;
 }
 
+size_t serial_send(const void *pbuf, size_t len)
+{
+    const uint8_t *p = pbuf;
+    size_t idx = 0;
+    if (p != NULL) {
+        len = serial_txAccept(len);
+        for (idx = 0; idx < len; idx++) {
+            serial_txPut(p[idx]);
+        }
+    }
+    return idx;
+}
+
+size_t serial_txRoom()
+{
+    return SERIAL_TX_RING - (uint8_t)(serial_txHead - serial_txTail);
+}
+
+void serial_flush()
+{
+    while (serial_txHead != serial_txTail) {
+        serial_txPoll();
+    }
+    /* the last byte leaves the shift register */
+    while (UCA0STAT & UCBUSY);
+}
+
 size_t getSerialBaud()
 {
     return SERIAL_BAUD;
@@ -116,7 +161,60 @@ size_t getSerialCount()
 #endif
 }
 
-/* Add ISR if required and not implemented via I2C driver. */
-#if (MOS_USES(UART) == 1) && (MOS_USES(I2C) != 2)
-#include "serialISR.h"
-#endif
\ No newline at end of file
+/**
+ * @brief   Bytes of a write of len the ring takes, per MOS_UART_TX_FULL.
+ */
+static size_t serial_txAccept(size_t len)
+{
+#if SERIAL_TX_FULL == SERIAL_TX_DROP
+    const size_t room = serial_txRoom();
+    return (len < room) ? len : room;
+#elif SERIAL_TX_FULL == SERIAL_TX_ATOMIC
+    /* a write longer than the ring never fits, it waits instead */
+    return ((len <= serial_txRoom()) || (len > SERIAL_TX_RING)) ? len : 0;
+#else
+    /* serial_txPut waits for room */
+    return len;
+#endif
+}
+
+/**
+ * @brief   Put a byte on the Tx ring, waiting for room if full. A
+ *          write from an ISR may have taken the room serial_txAccept
+ *          counted on, the byte then waits for it too.
+ */
+static void serial_txPut(uint8_t c)
+{
+    unsigned short sr;
+    int stored = 0;
+    while (!stored) {
+        sr = __get_interrupt_state();
+        /* a write from an ISR would take the same slot */
+        __disable_interrupt();
+        if (serial_txRoom() != 0) {
+            serial_txMEM[serial_txHead & (SERIAL_TX_RING - 1)] = c;
+            serial_txHead++;
+            /* the Tx interrupt takes it from here */
+            IE2 |= UCA0TXIE;
+            stored = 1;
+        }
+        __set_interrupt_state(sr);
+        if (!stored) {
+            serial_txPoll();
+        }
+    }
+}
+
+/**
+ * @brief   Waiting on the ring with interrupts disabled (eg a print
+ *          from an ISR), nothing drains it but this.
+ */
+static void serial_txPoll(void)
+{
+    if (!(__get_interrupt_state() & GIE)) {
+        serial_txHandler();
+    }
+}
+
+/* Add the Tx and Rx handlers. */
+#include "serialISR.h"
\ No newline at end of file
@@ -3,7 +3,7 @@
  * @author 	Mohit Rathod
  * Created: 17 09 2022, 07:51:28 am
  * -----
- * Last Modified: 18 07 2024, 02:46:04 pm
+ * Last Modified: 19 10 2026, 01:02:12 am
  * Modified By  : Mohit Rathod
  * -----
  * MIT License
@@ -37,7 +37,7 @@ int serial_getchar(uint8_t *p);
  * @fn      int serial_putchar(int c);
  * @brief   Write a character to Serial(UART) module.
  * @param   c   character to write 
- * @return  0 on success, -1 otherwise
+ * @return  0 on success, -1 if dropped (Tx ring full)
  */
 int serial_putchar(int c);
 
@@ -45,10 +45,41 @@ int serial_putchar(int c);
  * @fn      int serial_write(const char *str);
  * @brief   Write a string literal to Serial(UART) module.
  * @param   str string to write 
- * @return  0 on success, -1 otherwise
+ * @return  0 on success, -1 if it was dropped in part or in full
+ *          (Tx ring full)
+ * @note    Handled as serial_send, each line-feed counts two bytes.
  */
 int serial_write(const char *str);
 
+/**
+ * @fn      size_t serial_send(const void *pbuf, size_t len);
+ * @brief   Write bytes to Serial(UART) module. The bytes are queued on
+ *          the Tx ring and sent by the Tx interrupt, a full ring is
+ *          handled as MOS_UART_TX_FULL says (wait or drop), a write
+ *          longer than the ring waits even if the policy is to drop
+ *          the whole write. Safe from an ISR, its bytes may land
+ *          between those of a main loop write it preempts.
+ * @param   pbuf    bytes to write
+ * @param   len     number of bytes
+ * @return  number of bytes accepted
+ */
+size_t serial_send(const void *pbuf, size_t len);
+
+/**
+ * @fn      size_t serial_txRoom(void);
+ * @brief   Free space on the Tx ring, what a write takes without
+ *          waiting or dropping.
+ * @return  free bytes
+ */
+size_t serial_txRoom(void);
+
+/**
+ * @fn      void serial_flush(void);
+ * @brief   Wait until every byte written has been sent.
+ * @return  void
+ */
+void serial_flush(void);
+
 /**
  * @fn      size_t getSerialBaud(void);
  * @brief   Get the Serial Baud Rate in hecto bps
@@ -3,18 +3,34 @@
  * @author 	Mohit Rathod
  * Created: 21 09 2022, 10:20:09 pm
  * -----
- * Last Modified: 21 09 2022, 10:27:08 pm
+ * Last Modified: 19 10 2026, 12:21:50 am
  * Modified By  : Mohit Rathod
  * -----
  * MIT License
  * https://opensource.org/licenses/MIT
  * 
- * @brief   Interrupt service routine for serial module.
- *          This file is included in the driver when the
- *          serial rx mode is also implemented and the sys
- *          -tem doesn't use I2C module interrupts.
+ * @brief   Tx and Rx handlers of the serial module, registered on
+ *          the USCI vectors (@see usci.h). The Rx handler is included
+ *          when the serial rx mode is also implemented.
  */
-__attribute__((interrupt(USCIAB0RX_VECTOR))) void USCIAB0RX_ISR(void)
+
+/* Tx handler, sends the next byte of the Tx ring */
+static void serial_txHandler(void)
+{
+    if ((IE2 & UCA0TXIE) && (IFG2 & UCA0TXIFG)) {
+        if (serial_txHead != serial_txTail) {
+            UCA0TXBUF = serial_txMEM[serial_txTail & (SERIAL_TX_RING - 1)];
+            serial_txTail++;
+        } else {
+            /* ring empty, serial_txPut enables it again */
+            IE2 &= ~UCA0TXIE;
+        }
+    }
+}
+
+#if SERIAL_LITE != 1
+/* Rx handler */
+static void serial_rxHandler(void)
 {
     /* UART ISR */
     if (IFG2 & UCA0RXIFG) {
@@ -23,4 +39,5 @@ __attribute__((interrupt(USCIAB0RX_VECTOR))) void USCIAB0RX_ISR(void)
         IFG2 &= ~UCA0RXIFG;
         qEnqueue(serial_qID, &c);
     }
-}
\ No newline at end of file
+}
+#endif /* SERIAL_LITE */
\ No newline at end of file
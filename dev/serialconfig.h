@@ -3,7 +3,7 @@
  * @author 	Mohit Rathod
  * Created: 21 09 2022, 04:28:01 pm
  * -----
- * Last Modified: 21 09 2022, 09:39:13 pm
+ * Last Modified: 19 10 2026, 12:21:50 am
  * Modified By  : Mohit Rathod
  * -----
  * MIT License
@@ -19,6 +19,23 @@
 /* size of queue for serial driver(must be a power of 2) */
 #define SERIAL_QUEUE_LEN        (8)
 
+/* size of the Tx ring (must be a power of 2) */
+#if MOS_GET(UART_TX_RING)
+#define SERIAL_TX_RING          MOS_GET(UART_TX_RING)
+#else
+#define SERIAL_TX_RING          (32)
+#endif
+
+/* Tx ring full policy */
+#define SERIAL_TX_WAIT          (0)
+#define SERIAL_TX_DROP          (1)
+#define SERIAL_TX_ATOMIC        (2)
+#if MOS_GET(UART_TX_FULL)
+#define SERIAL_TX_FULL          MOS_GET(UART_TX_FULL)
+#else
+#define SERIAL_TX_FULL          SERIAL_TX_WAIT
+#endif
+
 /* Serial Tx only implementation requested? */
 #if MOS_USES(UART) == 2
 #define SERIAL_LITE             (1)
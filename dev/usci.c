@@ -0,0 +1,98 @@
+/** 
+ * @file 	usci.c
+ * @author 	Mohit Rathod
+ * Created: 19 10 2026, 12:31:07 am
+ * -----
+ * Last Modified: 19 10 2026, 12:31:07 am
+ * Modified By  : Mohit Rathod
+ * -----
+ * MIT License
+ * https://opensource.org/licenses/MIT
+ * 
+ * @brief   USCI interrupt dispatcher
+ * 
+ */
+#include <stddef.h>
+#include <mcu.h>
+#include "usci.h"
+
+typedef struct
+{
+    usciHandler_t pHandler;
+    uint8_t prio;
+} usciEntry_t;
+
+/* Handlers of a vector, sorted by priority */
+static usciEntry_t _handlers[USCI_VEC_MAX][USCI_HANDLERS_MAX];
+static uint8_t _num[USCI_VEC_MAX];
+
+int usci_register(usciVector_t vec, usciHandler_t pHandler, uint8_t prio)
+{
+    int ret = -1;
+    uint8_t idx;
+    usciEntry_t *pList;
+    const unsigned short sr = __get_interrupt_state();
+    if ((vec < USCI_VEC_MAX) && (pHandler != NULL)) {
+        pList = _handlers[vec];
+        /* the vector may be in use by another driver meanwhile */
+        __disable_interrupt();
+        for (idx = 0; (idx < _num[vec]) && (pList[idx].pHandler != pHandler); idx++);
+        if ((idx == _num[vec]) && (_num[vec] < USCI_HANDLERS_MAX)) {
+            /* insert behind the handlers of equal or higher priority */
+            for (idx = _num[vec]; (idx > 0) && (pList[idx - 1].prio > prio); idx--) {
+                pList[idx] = pList[idx - 1];
+            }
+            pList[idx].pHandler = pHandler;
+            pList[idx].prio = prio;
+            _num[vec]++;
+            ret = 0;
+        }
+        __set_interrupt_state(sr);
+    }
+    return ret;
+}
+
+int usci_unregister(usciVector_t vec, usciHandler_t pHandler)
+{
+    int ret = -1;
+    uint8_t idx;
+    usciEntry_t *pList;
+    const unsigned short sr = __get_interrupt_state();
+    if (vec < USCI_VEC_MAX) {
+        pList = _handlers[vec];
+        __disable_interrupt();
+        for (idx = 0; idx < _num[vec]; idx++) {
+            if (ret == 0) {
+                pList[idx - 1] = pList[idx];
+            }
+            else if (pList[idx].pHandler == pHandler) {
+                ret = 0;
+            }
+        }
+        _num[vec] -= (ret == 0);
+        __set_interrupt_state(sr);
+    }
+    return ret;
+}
+
+/**
+ * @brief   Run the handlers of a vector.
+ */
+static inline void usci_dispatch(usciVector_t vec)
+{
+    const usciEntry_t *pEntry = _handlers[vec];
+    const usciEntry_t *const pEnd = pEntry + _num[vec];
+    while (pEntry < pEnd) {
+        (pEntry++)->pHandler();
+    }
+}
+
+__attribute__((interrupt(USCIAB0TX_VECTOR))) void USCIAB0TX_ISR(void)
+{
+    usci_dispatch(USCI_VEC_TX);
+}
+
+__attribute__((interrupt(USCIAB0RX_VECTOR))) void USCIAB0RX_ISR(void)
+{
+    usci_dispatch(USCI_VEC_RX);
+}
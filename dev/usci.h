@@ -0,0 +1,69 @@
+/** 
+ * @file 	usci.h
+ * @author 	Mohit Rathod
+ * Created: 19 10 2026, 12:31:07 am
+ * -----
+ * Last Modified: 19 10 2026, 12:31:07 am
+ * Modified By  : Mohit Rathod
+ * -----
+ * MIT License
+ * https://opensource.org/licenses/MIT
+ * 
+ * @brief   USCI interrupt dispatcher.
+ *          USCI_A0 (UART, SPI) and USCI_B0 (I2C, SPI) share two
+ *          vectors, so their drivers register handlers here instead
+ *          of defining the ISRs. On every interrupt the handlers of
+ *          the vector run in priority order, each checks and clears
+ *          its own flags.
+ * 
+ *      USCI_VEC_TX => UCA0TXIFG, UCB0TXIFG, UCB0RXIFG (I2C)
+ *      USCI_VEC_RX => UCA0RXIFG, UCB0RXIFG (SPI), UCB0STAT (I2C)
+ * 
+ */
+#ifndef dev_usci_h
+#define dev_usci_h
+#include <stdint.h>
+
+/* Handlers per vector */
+#define USCI_HANDLERS_MAX       (4)
+
+/* Priorities, lowest runs first. By how long the peripheral can
+ * wait: the UART Rx buffer is overrun by the next byte (87 us at
+ * 115200), an SPI slave by the next master clock, an I2C bus is held
+ * by clock stretching, and a UART Tx only idles the line. */
+#define USCI_PRIO_UART_RX       (0)
+#define USCI_PRIO_SPI           (1)
+#define USCI_PRIO_I2C           (2)
+#define USCI_PRIO_UART_TX       (3)
+
+typedef enum
+{
+    USCI_VEC_TX,                /* USCIAB0TX_VECTOR */
+    USCI_VEC_RX,                /* USCIAB0RX_VECTOR */
+    USCI_VEC_MAX
+} usciVector_t;
+
+typedef void (*usciHandler_t)(void);
+
+/**
+ * @fn      int usci_register(usciVector_t, usciHandler_t, uint8_t);
+ * @brief   Register a handler on a USCI vector.
+ * @param   vec         the vector.
+ * @param   pHandler    handler, runs in the ISR.
+ * @param   prio        USCI_PRIO_x, handlers of equal priority run in
+ *                      the order they were registered.
+ * @return  0 on success, -1 if the vector has no room or the
+ *          handler is already registered on it.
+ */
+int usci_register(usciVector_t vec, usciHandler_t pHandler, uint8_t prio);
+
+/**
+ * @fn      int usci_unregister(usciVector_t, usciHandler_t);
+ * @brief   Remove a handler from a USCI vector.
+ * @param   vec         the vector.
+ * @param   pHandler    the handler.
+ * @return  0 on success, -1 otherwise.
+ */
+int usci_unregister(usciVector_t vec, usciHandler_t pHandler);
+
+#endif /* dev_usci_h */
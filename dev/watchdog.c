@@ -3,7 +3,7 @@
  * @author 	Mohit Rathod
  * Created: 23 09 2022, 08:29:40 pm
  * -----
- * Last Modified: 23 09 2022, 08:34:09 pm
+ * Last Modified: 19 10 2026, 12:17:39 am
  * Modified By  : Mohit Rathod
  * -----
  * MIT License
@@ -15,6 +15,9 @@
 #include <mcu.h>
 #include "watchdog.h"
 
+/* Not cleared by the startup code, so it survives a watchdog reset */
+static uint8_t wdtResets __attribute__((section(".noinit")));
+
 void watchdog_disable()
 {
     /* Hold the watchdog */
@@ -23,14 +26,27 @@ void watchdog_disable()
 
 void watchdog_enable()
 {
+    /* Power-on, the RAM holds no count yet */
+    if (IFG1 & PORIFG) {
+        IFG1 &= ~PORIFG;
+        wdtResets = 0;
+    }
     /* Read the watchdog interrupt flag */
     if (IFG1 & WDTIFG) {
         /* clear the flag */
         IFG1 &= ~WDTIFG;
+        if (wdtResets != UINT8_MAX) {
+            wdtResets++;
+        }
     }
     watchdog_pet();
 }
 
+uint8_t watchdog_resets()
+{
+    return wdtResets;
+}
+
 void watchdog_pet()
 {
     /**
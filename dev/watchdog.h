@@ -3,7 +3,7 @@
  * @author 	Mohit Rathod
  * Created: 23 09 2022, 07:47:13 pm
  * -----
- * Last Modified: 23 09 2022, 07:57:01 pm
+ * Last Modified: 19 10 2026, 12:17:39 am
  * Modified By  : Mohit Rathod
  * -----
  * MIT License
@@ -14,6 +14,7 @@
  */
 #ifndef dev_watchdog_h
 #define dev_watchdog_h
+#include <stdint.h>
 
 /**
  * @fn      void watchdog_disable(void);
@@ -29,6 +30,14 @@ void watchdog_disable(void);
  */
 void watchdog_enable(void);
 
+/**
+ * @fn      uint8_t watchdog_resets(void);
+ * @brief   Number of watchdog resets since power-on, counted by
+ *          @ref watchdog_enable. Stops at 255.
+ * @return  reset count
+ */
+uint8_t watchdog_resets(void);
+
 /**
  * @brief   Pet the watchdog. Keeps it from resetting the system.
  * @fn      void watchdog_pet(void);
@@ -3,7 +3,7 @@
  * @author 	Mohit Rathod
  * Created: 24 09 2022, 08:42:04 am
  * -----
- * Last Modified: 24 09 2022, 10:37:50 pm
+ * Last Modified: 19 10 2026, 01:01:28 am
  * Modified By  : Mohit Rathod
  * -----
  * MIT License
@@ -19,17 +19,29 @@
 #include <dev/sysled.h>
 #include <dev/watchdog.h>
 #include <utils/banner.h>
+#if MOS_USES(STATS)
+#include <mosstat.h>
+#endif
 
 int main(void)
 {
+#if MOS_USES(STATS)
+    mosstat_paint();
+#endif
     if (board_init() == 0) {
         mossAddTask(sysled_TOGGLE, 10, 50);
         setup();
+#if MOS_USES(STATS)
+        mosstat_init();
+#endif
         mOSgreet();
         while (1) {
             watchdog_pet();
             mossRun();
             loop();
+#if MOS_USES(STATS)
+            mosstat_loop();
+#endif
         }
     }
     return 0;
@@ -3,7 +3,7 @@
  * @author 	Mohit Rathod
  * Created: 16 09 2022, 10:55:47 am
  * -----
- * Last Modified: 18 07 2024, 02:42:58 pm
+ * Last Modified: 19 10 2026, 01:02:12 am
  * Modified By  : Mohit Rathod
  * -----
  * MIT License
@@ -73,6 +73,25 @@
  * @note    [x] => default baud.
  */
 #define MOS_UART_BAUD           (115200)
+
+/**
+ * @def     MOS_UART_TX_RING
+ * @brief   Configures the UART Tx ring, drained by the Tx interrupt.
+ * @param   len[bytes]  { 16, [32], 64, 128 }
+ * @note    [x] => default length.
+ */
+#define MOS_UART_TX_RING        (32)
+
+/**
+ * @def     MOS_UART_TX_FULL
+ * @brief   Configures what a UART write does when the Tx ring is full.
+ * @param   policy     [0] - waits for room
+ *                      1  - drops the bytes that don't fit
+ *                      2  - drops the whole write unless it fits,
+ *                           one longer than the ring waits as 0
+ * @note    [x] => default policy.
+ */
+#define MOS_UART_TX_FULL        (0)
 #endif
 /** @} */ //UART configuration
 
@@ -97,6 +116,15 @@
  * @note    [x] => default speed.
  */
 #define MOS_I2C_SPEED           (100000)
+
+/**
+ * @def     MOS_I2C_QUEUE
+ * @brief   Configures the number of transactions queued by the I2C
+ *          master driver.
+ * @param   depth       { 1, 2, [4], 8 }
+ * @note    [x] => default depth.
+ */
+#define MOS_I2C_QUEUE           (4)
 #endif
 /** @} I2C configuration */
 
@@ -187,8 +215,186 @@
  */ 
 #define MOS_SMF_MAX_STATES      (5)
 
+/**
+ * @def     MOS_SMF_MAX_INSTANCES
+ * @brief   Configures the max. number of state machine instances
+ *          that can run concurrently in the framework.
+ * @param   iMax       { 1, [2], 3, 4 }
+ * @note    [x] => default instance max value.
+ *          Every instance uses one queue, @see MOS_MAX_QUEUE
+ */
+#define MOS_SMF_MAX_INSTANCES   (2)
+
+/**
+ * @def     MOS_CONFIG_SMF_SPARSE
+ * @brief   Configures the transition table layout of the dynamic SMF.
+ * @param   state       1 - sorted transition list per state,
+ *                          memory grows with the transitions used.
+ *                      [0] - dense state x event matrix,
+ *                          fastest lookup for small machines.
+ * @note    [x] => default layout.
+ *          On the msp430 a state takes 2 B per event dense, and 4 B
+ *          plus 4 B per transition sparse (heap overhead aside), so
+ *          sparse is smaller only when states handle fewer than
+ *          (events - 2) / 2 transitions, eg 16 x 16 with 3 per state
+ *          (258 vs 514 B). At 8 x 8 the two are equal and at 8 x 4
+ *          dense is half the size. Sparse lookups take ~10x longer
+ *          (binary search), @see tools/smfbench.c.
+ */
+#define MOS_CONFIG_SMF_SPARSE   (0)
+
+/**
+ * @def     MOS_CONFIG_SMF_TRACE
+ * @brief   Configures the SMF transition trace
+ * @param   state       1 - transition trace enabled
+ *                      0 - transition trace disabled
+ */
+#define MOS_CONFIG_SMF_TRACE    (1)
+
+/**
+ * @def     MOS_CONFIG_SMF_COALESCE
+ * @brief   Configures event coalescing in the SMF event queues
+ * @param   state       1 - coalescing rules may be set per instance
+ *                      0 - every event is queued
+ */
+#define MOS_CONFIG_SMF_COALESCE (1)
+
+#if MOS_USES(SMF_TRACE)
+/**
+ * @def     MOS_SMF_TRACE_LEN
+ * @brief   Configures the number of transitions held in the
+ *          trace ring buffer (4 bytes each).
+ * @param   tLen       { 8, [16] }
+ * @note    [x] => default trace length.
+ * @note    Served on an ICS port (SMF_traceInit) the trace also takes
+ *          two response snapshots of 1 + 4 * tLen bytes, and with
+ *          MOS_CONFIG_ICS_SLIP the SLIP frame buffer grows to fit one
+ *          (@see slipframe.h).
+ */
+#define MOS_SMF_TRACE_LEN       (16)
+#endif /* MOS_USES(SMF_TRACE) */
+
 /** @} SMF configuration */
 
+/** 
+ * I2C Simple Server(ICS) configuration 
+ * @{
+ */
+/**
+ * @def     MOS_ICS_PORTS
+ * @brief   Configures the number of ICS service ports, PORT_0 onwards.
+ * @param   ports       { 1, 2, 3, 4, [5], 6, 7, 8 }
+ * @note    [x] => default port nums.
+ *          ICS_run only visits ports with queued requests, so the
+ *          idle cost doesn't grow with the number of ports.
+ */
+#define MOS_ICS_PORTS           (5)
+
+/**
+ * @def     MOS_ICS_REQ_DEPTH
+ * @brief   Configures the number of requests queued per ICS port
+ *          ahead of the service.
+ * @param   depth       { 1, [2], 4, 8 }
+ * @note    [x] => default depth.
+ */
+#define MOS_ICS_REQ_DEPTH       (2)
+
+/**
+ * @def     MOS_ICS_DONE_DEPTH
+ * @brief   Configures the number of completed requests held for
+ *          collection by the host (ISMP_DONE_HEADER).
+ * @param   depth       { 1, 2, [4], 8 }
+ * @note    [x] => default depth.
+ */
+#define MOS_ICS_DONE_DEPTH      (4)
+
+/**
+ * @def     MOS_ICS_BATCH_LEN
+ * @brief   Configures the max. length of an ISMP batch frame
+ *          (request ID and records).
+ * @param   len[bytes]  { 2 to [12] to 255 }
+ * @note    [x] => default length.
+ */
+#define MOS_ICS_BATCH_LEN       (12)
+
+/**
+ * @def     MOS_ICS_RX_RING
+ * @brief   Configures the size of the ring the I2C ISR copies ISMP
+ *          frames into until they are parsed.
+ * @param   len[bytes]  { [32], 64, 128 }
+ * @note    [x] => default length. A power of 2 that holds the longest
+ *          frame plus a length byte, a frame that doesn't fit is
+ *          dropped and reported as FRAME_OK_SRVC_BUSY.
+ */
+#define MOS_ICS_RX_RING         (32)
+
+/**
+ * @def     MOS_CONFIG_ICS_SLIP
+ * @brief   Configures the SLIP/UART transport of the ICS server
+ * @param   state       1 - ICS ports also served over the UART
+ *                      0 - ICS ports served over I2C only
+ * @note    Needs MOS_CONFIG_UART 1.
+ */
+#define MOS_CONFIG_ICS_SLIP     (1)
+
+/**
+ * @def     MOS_CONFIG_ICS_FLOWCTL
+ * @brief   Configures flow control of the ICS server over I2C
+ * @param   state       1 - frames that can't be taken are NACKed from
+ *                          the byte after the header (no room in
+ *                          the rx ring, batch pending) or after the
+ *                          port (request queue full)
+ *                      0 - such frames are read in full and reported
+ *                          FRAME_OK_SRVC_BUSY
+ */
+#define MOS_CONFIG_ICS_FLOWCTL  (0)
+
+/**
+ * @def     MOS_CONFIG_ICS_DEFER
+ * @brief   Configures where I2C frames are parsed, the ISR copies
+ *          their bytes into the ring either way
+ * @param   state       1 - by ICS_run, the STOP interrupt is short;
+ *                          a status read returns ISMP_ONGOING until
+ *                          the main loop has parsed the frame, so
+ *                          hosts must poll it
+ *                      0 - in the STOP interrupt, a status read right
+ *                          after the frame returns its response
+ */
+#define MOS_CONFIG_ICS_DEFER    (0)
+/** @} ICS configuration */
+
+/** 
+ * mOS statistics configuration 
+ * @{
+ */
+/**
+ * @def     MOS_CONFIG_STATS
+ * @brief   Configures the mOS runtime statistics (@see mosstat.h)
+ * @param   state       1 - statistics served on an ICS port
+ *                      0 - statistics disabled
+ * @note    Needs MOS_CONFIG_I2C 2 and the ICS server.
+ * @note    RAM cost when enabled: the response block, one copy of
+ *          MOSSTAT_LEN bytes (41 B with 4 queues and 3 ICS counters),
+ *          14 B of counters (uptime, loops, loop rate, second tick),
+ *          and, with MOS_CONFIG_ICS_SLIP, the SLIP frame buffer grows
+ *          to fit the block (@see slipframe.h). The free RAM check
+ *          paints the stack at reset, costing time only. The queue,
+ *          overrun and ICS counters are kept either way.
+ */
+#define MOS_CONFIG_STATS        (1)
+
+#if MOS_USES(STATS)
+/**
+ * @def     MOS_STATS_PORT
+ * @brief   Configures the ICS port of the statistics, PORT_0 + n.
+ *          The application must leave it free.
+ * @param   n           { 1 to MOS_ICS_PORTS - 1 }
+ * @note    Defaults to the last port.
+ */
+#define MOS_STATS_PORT          (4)
+#endif /* MOS_USES(STATS) */
+/** @} mOS statistics configuration */
+
 /** 
  *  configuration 
  * @{
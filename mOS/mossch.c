@@ -3,7 +3,7 @@
  * @author 	Mohit Rathod
  * Created: 23 09 2022, 04:31:05 pm
  * -----
- * Last Modified: 23 09 2022, 07:37:10 pm
+ * Last Modified: 19 10 2026, 01:01:28 am
  * Modified By  : Mohit Rathod
  * -----
  * MIT License
@@ -18,6 +18,9 @@
 #include <stddef.h>
 #include <dev/clock.h>
 #include "mossch.h"
+#if MOS_USES(I2C) == 1
+#include <dev/i2cmaster.h>
+#endif
 
 /* If invalid number of application tasks configured revert to default value. */
 #if (MOS_GET(APP_TASKS) != 0) && \
@@ -30,7 +33,7 @@
 #endif
 
 #define SYS_CLK_FREQ            MOS_GET(MCLK_FREQ)*1000000
-#define TICK_RESOLUTION_MS      10
+#define TICK_RESOLUTION_MS      MOSS_TICK_MS
 
 
 #define MaxTASK                 1 + MOS_GET(APP_TASKS)
@@ -46,6 +49,8 @@ typedef struct mossch
 }sTask_t;
 
 static sTask_t _tasks[MaxTASK];
+static volatile uint16_t _ticks;
+static volatile uint16_t _overruns;
 
 int moss_init()
 {
@@ -102,6 +107,8 @@ void mossUpdate()
 {
     int taskID;
 
+    _ticks++;
+
     for (taskID = 0; taskID < MaxTASK; taskID++) {
         /* Is there a valid task? */
         if (_tasks[taskID].pTask != NULL) {
@@ -111,7 +118,10 @@ void mossUpdate()
                     /* Schedule it to run again. */
                     _tasks[taskID].delay = _tasks[taskID].period - 1;
                 }
-                /* task is due to run now. */
+                /* task is due to run now, its last run still pending? */
+                if (_tasks[taskID].run > 0) {
+                    _overruns++;
+                }
                 _tasks[taskID].run++;
             }
             else {
@@ -136,11 +146,25 @@ void mossRun()
     }
 }
 
+uint16_t mossTicks()
+{
+    return _ticks;
+}
+
+uint16_t mossOverruns()
+{
+    return _overruns;
+}
+
 // Timer A0 interrupt service routine
 __attribute__ ((interrupt(TIMER0_A0_VECTOR))) void TimerA0_ISR(void)
 {
   /* Clear the interrupt flag */
   TA0CCTL0 &= ~CCIFG;
   mossUpdate();
+#if MOS_USES(I2C) == 1
+  /* the bus phases without an interrupt of their own */
+  i2cmaster_poll();
+#endif
   TA0CCR0 += SCH_PERIOD;
 }
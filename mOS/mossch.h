@@ -3,7 +3,7 @@
  * @author 	Mohit Rathod
  * Created: 23 09 2022, 10:32:25 am
  * -----
- * Last Modified: 23 09 2022, 06:16:24 pm
+ * Last Modified: 19 10 2026, 12:17:39 am
  * Modified By  : Mohit Rathod
  * -----
  * MIT License
@@ -29,6 +29,9 @@
 #include <mosconfig.h>
 #include <stdint.h>
 
+/* Scheduler tick period in ms */
+#define MOSS_TICK_MS            (10)
+
 /**
  * @typedef typedef void (*task_t)(void);
  * @brief   typedef for scheduler tasks.
@@ -98,4 +101,24 @@ void mossUpdate(void);
  */
 void mossRun(void);
 
+/**
+ * @fn      uint16_t mossTicks(void);
+ * @brief   Number of scheduler ticks elapsed since @ref moss_init.
+ *          The count wraps around, so use the (unsigned) difference
+ *          of two readings to measure an interval.
+ * @param   void
+ * @return  tick count (@ref MOSS_TICK_MS each)
+ */
+uint16_t mossTicks(void);
+
+/**
+ * @fn      uint16_t mossOverruns(void);
+ * @brief   Number of times a task fell due while its last run was
+ *          still pending, ie the tasks and the main loop took longer
+ *          than the task period. The count wraps around.
+ * @param   void
+ * @return  overrun count
+ */
+uint16_t mossOverruns(void);
+
 #endif /* mos_scheduler_h */
\ No newline at end of file
@@ -0,0 +1,125 @@
+/** 
+ * @file 	mosstat.c
+ * @author 	Mohit Rathod
+ * Created: 19 10 2026, 12:20:41 am
+ * -----
+ * Last Modified: 19 10 2026, 12:43:06 am
+ * Modified By  : Mohit Rathod
+ * -----
+ * MIT License
+ * https://opensource.org/licenses/MIT
+ * 
+ * @brief   mOS runtime statistics
+ * 
+ */
+#include <mossch.h>
+#include <dev/watchdog.h>
+#include "mosstat.h"
+
+static_assert(MOSSTAT_PORT < (PORT_0 + PORT_NUM_MAX),
+                "MOS_STATS_PORT must be one of the MOS_ICS_PORTS");
+
+#define STACK_PAINT             (0xA5)
+/* Left unpainted below the stack pointer of mosstat_paint */
+#define STACK_MARGIN            (16)
+#define TICKS_PER_SEC           (1000 / MOSS_TICK_MS)
+
+/* Linker symbols, the end of the RAM sections (.noinit included) and
+ * the top of the stack */
+extern uint8_t end;
+extern uint8_t __stack;
+
+/* Built in place by the service, one copy (@see ICS_setSingleResponse) */
+static uint8_t rspBuf[MOSSTAT_LEN];
+static uint32_t uptime;
+static uint32_t loops;
+static uint32_t loopRate;
+static uint16_t secTick;
+
+static uint8_t mosstat_service(void *pargs);
+static uint16_t stackUsed(void);
+static uint8_t *put16(uint8_t *pDst, uint16_t val);
+static uint8_t *put32(uint8_t *pDst, uint32_t val);
+
+void mosstat_paint()
+{
+    uint8_t mark;
+    uint8_t *const top = (uint8_t *)((uintptr_t)&mark - STACK_MARGIN);
+    uint8_t *p;
+    for (p = &end; p < top; p++) {
+        *p = STACK_PAINT;
+    }
+}
+
+int mosstat_init()
+{
+    int ret = -1;
+    secTick = mossTicks();
+    if (ICS_addService(mosstat_service, 0, NULL, MOSSTAT_PORT) == 0) {
+        ret = ICS_setSingleResponse(MOSSTAT_PORT, rspBuf, MOSSTAT_LEN);
+    }
+    return ret;
+}
+
+void mosstat_loop()
+{
+    loops++;
+    /* the main loop comes round well within the wrap of the ticks */
+    while ((uint16_t)(mossTicks() - secTick) >= TICKS_PER_SEC) {
+        secTick += TICKS_PER_SEC;
+        uptime++;
+        loopRate = loops;
+        loops = 0;
+    }
+}
+
+/**
+ * @brief   Statistics service, fills the response with a snapshot.
+ */
+static uint8_t mosstat_service(void *pargs)
+{
+    uint8_t *pDst = ICS_rspBuffer(MOSSTAT_PORT);
+    uint8_t idx;
+    IGNORE(pargs);
+    *pDst++ = MOSSTAT_VERSION;
+    pDst = put32(pDst, uptime);
+    pDst = put32(pDst, loopRate);
+    pDst = put16(pDst, mossOverruns());
+    *pDst++ = watchdog_resets();
+    pDst = put16(pDst, stackUsed());
+    *pDst++ = QUEUE_MAX;
+    for (idx = 0; idx < QUEUE_MAX; idx++) {
+        pDst = put16(pDst, qDrops(idx));
+    }
+    for (idx = 0; idx < ICS_STAT_NUM; idx++) {
+        pDst = put16(pDst, ICS_getStat(idx));
+    }
+    ICS_commitResponse(MOSSTAT_PORT);
+    return 0;
+}
+
+/**
+ * @brief   Stack used at its deepest, the painted bytes left untouched
+ *          are the ones it never reached.
+ */
+static uint16_t stackUsed(void)
+{
+    const uint8_t *p = &end;
+    while ((p < &__stack) && (*p == STACK_PAINT)) {
+        p++;
+    }
+    return (uint16_t)(&__stack - p);
+}
+
+static uint8_t *put16(uint8_t *pDst, uint16_t val)
+{
+    *pDst++ = (uint8_t)val;
+    *pDst++ = (uint8_t)(val >> 8);
+    return pDst;
+}
+
+static uint8_t *put32(uint8_t *pDst, uint32_t val)
+{
+    pDst = put16(pDst, (uint16_t)val);
+    return put16(pDst, (uint16_t)(val >> 16));
+}
@@ -0,0 +1,78 @@
+/** 
+ * @file 	mosstat.h
+ * @author 	Mohit Rathod
+ * Created: 19 10 2026, 12:20:41 am
+ * -----
+ * Last Modified: 19 10 2026, 12:43:06 am
+ * Modified By  : Mohit Rathod
+ * -----
+ * MIT License
+ * https://opensource.org/licenses/MIT
+ * 
+ * @brief   mOS runtime statistics, served on an ICS port of their own
+ *          (MOS_STATS_PORT) registered by mOS after the application
+ *          setup. Running the port's service takes a snapshot, reading
+ *          the port returns it as a multi-byte response (@see
+ *          ICS_setSingleResponse). Multi-byte values are LSB first, counters
+ *          wrap around so a monitor uses the difference of two reads.
+ * 
+ *  Statistics block
+ * 
+ *  |Ver|Uptime|Loops|Overruns|Resets|Stack|Queues|Drops..|Frames..|
+ *  Ver      => MOSSTAT_VERSION
+ *  Uptime   => 4 bytes, seconds since the last reset
+ *  Loops    => 4 bytes, main loop iterations in the last full second
+ *  Overruns => 2 bytes, scheduler overruns (@see mossOverruns)
+ *  Resets   => watchdog resets since power-on (@see watchdog_resets)
+ *  Stack    => 2 bytes, most stack used since the last reset (bytes)
+ *  Queues   => number of queues (QUEUE_MAX)
+ *  Drops    => 2 bytes per queue, elements refused (@see qDrops)
+ *  Frames   => 2 bytes per ICS counter, in icsStat_t order
+ *              (@see ICS_getStat)
+ * 
+ */
+#ifndef mos_stat_h
+#define mos_stat_h
+#include <mosconfig.h>
+#include <utils/queue.h>
+#include <utils/icsserver.h>
+
+#define MOSSTAT_VERSION         (0x01)
+#define MOSSTAT_LEN             (15 + (2 * QUEUE_MAX) + (2 * ICS_STAT_NUM))
+
+/* Port of the statistics service */
+#if MOS_GET(STATS_PORT)
+#define MOSSTAT_PORT            (PORT_0 + MOS_GET(STATS_PORT))
+#else
+#define MOSSTAT_PORT            (PORT_0 + PORT_NUM_MAX - 1)
+#endif
+
+/**
+ * @fn      void mosstat_paint(void);
+ * @brief   Fill the free stack with a pattern, for the high-water mark.
+ *          Called first thing in main, with interrupts still disabled.
+ * @param   void
+ * @return  void
+ */
+void mosstat_paint(void);
+
+/**
+ * @fn      int mosstat_init(void);
+ * @brief   Register the statistics service on MOSSTAT_PORT.
+ *          Called after the application setup, which initializes the
+ *          ICS server and must leave the port free.
+ * @param   void
+ * @return  0 on success, -1 otherwise
+ */
+int mosstat_init(void);
+
+/**
+ * @fn      void mosstat_loop(void);
+ * @brief   Count a main loop iteration and keep the uptime.
+ *          Called once every main loop iteration.
+ * @param   void
+ * @return  void
+ */
+void mosstat_loop(void);
+
+#endif /* mos_stat_h */
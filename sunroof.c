@@ -0,0 +1,119 @@
+/** 
+ * @file 	sunroof.c
+ * @author 	Mohit Rathod
+ * Created: 18 10 2026, 01:12:40 pm
+ * -----
+ * Last Modified: 18 10 2026, 11:54:49 pm
+ * Modified By  : Mohit Rathod
+ * -----
+ * MIT License
+ * https://opensource.org/licenses/MIT
+ * 
+ * @brief   Sunroof state machine of the user application.
+ * 
+ */
+#include <mos.h>
+#include <dev/md13s.h>
+#include "sunroof.h"
+
+static state_t openEvent_Handler(void *pCtx);
+static state_t closeEvent_Handler(void *pCtx);
+static state_t stopEvent_Handler(void *pCtx);
+static state_t limit_openEvent_Handler(void *pCtx);
+static state_t limit_closeEvent_Handler(void *pCtx);
+static state_t resetEvent_Handler(void *pCtx);
+
+const smfTable_t sunroofTable = {
+    .action = {
+        /* event action pair for ST_OPEN case */
+        SMF_STATE(ST_OPEN) = {
+            SMF_EVENT(EV_CLOSE)     = closeEvent_Handler,
+            SMF_EVENT(EV_STOP)      = stopEvent_Handler
+        },
+        /* event action pair for ST_CLOSE case */
+        SMF_STATE(ST_CLOSE) = {
+            SMF_EVENT(EV_OPEN)      = openEvent_Handler,
+            SMF_EVENT(EV_STOP)      = stopEvent_Handler
+        },
+        /* event action pair for ST_OPENING case */
+        SMF_STATE(ST_OPENING) = {
+            SMF_EVENT(EV_LIMIT)     = limit_openEvent_Handler,
+            SMF_EVENT(EV_CLOSE)     = closeEvent_Handler,
+            SMF_EVENT(EV_STOP)      = stopEvent_Handler
+        },
+        /* event action pair for ST_CLOSING case */
+        SMF_STATE(ST_CLOSING) = {
+            SMF_EVENT(EV_LIMIT)     = limit_closeEvent_Handler,
+            SMF_EVENT(EV_OPEN)      = openEvent_Handler,
+            SMF_EVENT(EV_STOP)      = stopEvent_Handler
+        },
+        /* event action pair for ST_STOPPED case */
+        SMF_STATE(ST_STOPPED) = {
+            SMF_EVENT(EV_FSM_RST)   = resetEvent_Handler
+        }
+    },
+    /* stop the motor if a limit isn't reached in time */
+    .timeout = {
+        SMF_STATE(ST_OPENING)       = { TRAVEL_TIMEOUT_MS, EV_STOP },
+        SMF_STATE(ST_CLOSING)       = { TRAVEL_TIMEOUT_MS, EV_STOP }
+    }
+};
+
+#if MOS_USES(SMF_COALESCE)
+const uint8_t sunroofEventClass[EVENTSMAX] = {
+    /* a pending open/close command is overwritten by a newer one */
+    SMF_EVENT(EV_OPEN)      = SR_CLASS_MOVE,
+    SMF_EVENT(EV_CLOSE)     = SR_CLASS_MOVE,
+    /* stop, reset and limits are never coalesced */
+    SMF_EVENT(EV_STOP)      = SMF_CLASS_NONE,
+    SMF_EVENT(EV_FSM_RST)   = SMF_CLASS_NONE,
+    SMF_EVENT(EV_LIMIT)     = SMF_CLASS_NONE
+};
+#endif
+
+static state_t openEvent_Handler(void *pCtx)
+{
+  IGNORE(pCtx);
+  md13s_run(MD_CW);
+  MPRINT("\nOpen Event Handler.");
+  return ST_OPENING;
+}
+
+static state_t closeEvent_Handler(void *pCtx)
+{
+  IGNORE(pCtx);
+  md13s_run(MD_CCW);
+  MPRINT("\nClose Event Handler.");
+  return ST_CLOSING;
+}
+
+static state_t stopEvent_Handler(void *pCtx)
+{
+  IGNORE(pCtx);
+  md13s_stop();
+  MPRINT("\nStop Event Handler.");
+  return ST_STOPPED;
+}
+
+static state_t limit_openEvent_Handler(void *pCtx)
+{
+  IGNORE(pCtx);
+  md13s_stop();
+  MPRINT("\nLimit(o)Event Handler.");
+  return ST_OPEN;
+}
+
+static state_t limit_closeEvent_Handler(void *pCtx)
+{
+  IGNORE(pCtx);
+  md13s_stop();
+  MPRINT("\nLimit(c)Event Handler.");
+  return ST_CLOSE;
+}
+
+static state_t resetEvent_Handler(void *pCtx)
+{
+  IGNORE(pCtx);
+  MPRINT("\nReset Event Handler.");
+  return ST_CLOSE;
+}
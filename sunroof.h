@@ -0,0 +1,60 @@
+/** 
+ * @file 	sunroof.h
+ * @author 	Mohit Rathod
+ * Created: 18 10 2026, 01:12:40 pm
+ * -----
+ * Last Modified: 18 10 2026, 11:54:49 pm
+ * Modified By  : Mohit Rathod
+ * -----
+ * MIT License
+ * https://opensource.org/licenses/MIT
+ * 
+ * @brief   Sunroof state machine of the user application.
+ *          Kept apart from app.c so the table and its actions can
+ *          also be linked into the host-side SMF tools.
+ */
+#ifndef app_sunroof_h
+#define app_sunroof_h
+#include <utils/smf.h>
+
+/* Map sunroof events to StateMachine */
+#define EV_OPEN       EVENT_0
+#define EV_CLOSE      EVENT_1
+#define EV_STOP       EVENT_2
+#define EV_FSM_RST    EVENT_3
+#define EV_LIMIT      EVENT_4
+
+/* Map sunroof states to StateMachine */
+#define ST_OPEN       STATE_0
+#define ST_OPENING    STATE_1
+#define ST_CLOSE      STATE_2
+#define ST_CLOSING    STATE_3
+#define ST_STOPPED    STATE_4
+
+/* State the sunroof machine starts in */
+#define SUNROOF_INIT_STATE  ST_CLOSE
+
+/* State every other state must be able to reach (motor stopped) */
+#define SUNROOF_STOP_STATE  ST_STOPPED
+
+/* Max. time the motor may run before a limit is expected, in ms */
+#define TRAVEL_TIMEOUT_MS   (15000)
+
+/**
+ * @brief   Sunroof transition table, in flash and shareable by
+ *          identical machines.
+ */
+extern const smfTable_t sunroofTable;
+
+#if MOS_USES(SMF_COALESCE)
+/* Event class of the motor commands */
+#define SR_CLASS_MOVE       (0)
+
+/**
+ * @brief   Coalescing class of the sunroof events,
+ *          for SMF_COALESCE_REPLACE_CLASS.
+ */
+extern const uint8_t sunroofEventClass[EVENTSMAX];
+#endif
+
+#endif /* app_sunroof_h */
@@ -0,0 +1,185 @@
+/** 
+ * @file 	hoststub.c
+ * @author 	Mohit Rathod
+ * Created: 18 10 2026, 02:03:11 pm
+ * -----
+ * Last Modified: 19 10 2026, 12:44:08 am
+ * Modified By  : Mohit Rathod
+ * -----
+ * MIT License
+ * https://opensource.org/licenses/MIT
+ * 
+ * @brief   Host (Linux) stand-ins for the mOS drivers.
+ * 
+ */
+#include <stdio.h>
+#include <mosprint.h>
+#include <mossch.h>
+#include <dev/md13s.h>
+#include <dev/serial.h>
+#include <dev/i2cslave.h>
+#include "hoststub.h"
+
+uint16_t hostTicks;
+int hostVerbose;
+
+static void (*i2cState)(void);
+static void (*i2cTx)(volatile uint8_t *value);
+static void (*i2cRx)(const uint8_t value);
+static int i2cNack;
+static int i2cStop;
+
+uint16_t mossTicks()
+{
+    return hostTicks;
+}
+
+void oprint(const char* str, int *ptr)
+{
+    if (hostVerbose) {
+        fputs(str, stdout);
+        if (ptr != NULL) {
+            printf("%d", *ptr);
+        }
+    }
+}
+
+void eprint(const char* str)
+{
+    oprint(str, NULL);
+}
+
+void md13s_run(mCmd_t uCmd)
+{
+    (void) uCmd;
+}
+
+void md13s_stop(void)
+{
+}
+
+void md13s_setDuty(uint8_t duty)
+{
+    (void) duty;
+}
+
+int serial_putchar(int c)
+{
+    (void) c;
+    return 0;
+}
+
+size_t serial_send(const void *pbuf, size_t len)
+{
+    (void) pbuf;
+    return len;
+}
+
+int serial_getchar(uint8_t *p)
+{
+    (void) p;
+    return -1;
+}
+
+size_t getSerialCount()
+{
+    return 0;
+}
+
+int i2cslave_init(void (*State_Callback)(),
+                   void (*Tx_Callback)(volatile uint8_t *value),
+                   void (*Rx_Callback)(const uint8_t value),
+                   uint8_t slave_address)
+{
+    (void) slave_address;
+    i2cState = State_Callback;
+    i2cTx = Tx_Callback;
+    i2cRx = Rx_Callback;
+    return 0;
+}
+
+void i2cslave_nack(void)
+{
+    i2cNack = 1;
+}
+
+int i2cslave_isStop(void)
+{
+    return i2cStop;
+}
+
+/**
+ * @brief   START (or repeated START) or STOP condition on the bus.
+ */
+static void hostI2cCond(int stop)
+{
+    i2cStop = stop;
+    i2cState();
+    i2cStop = 0;
+}
+
+/**
+ * @brief   Bytes written by the master, after a (repeated) START.
+ */
+static int hostI2cTx(const uint8_t *pbuf, int len)
+{
+    int ret = 0;
+    i2cNack = 0;
+    while (len--) {
+        /* a refused byte ends the write, as a master would */
+        if (i2cNack) {
+            ret = -1;
+            break;
+        }
+        i2cRx(*pbuf++);
+    }
+    return ret;
+}
+
+/**
+ * @brief   Bytes read by the master, after a (repeated) START.
+ */
+static void hostI2cRx(uint8_t *pbuf, int len)
+{
+    volatile uint8_t txbuf;
+    while (len--) {
+        txbuf = 0xFF;
+        i2cTx(&txbuf);
+        *pbuf++ = txbuf;
+    }
+}
+
+int hostI2cWrite(const uint8_t *pbuf, int len)
+{
+    int ret = 0;
+    if (i2cRx != NULL) {
+        hostI2cCond(0);
+        ret = hostI2cTx(pbuf, len);
+        hostI2cCond(1);
+    }
+    return ret;
+}
+
+void hostI2cRead(uint8_t *pbuf, int len)
+{
+    if (i2cTx != NULL) {
+        hostI2cCond(0);
+        hostI2cRx(pbuf, len);
+        hostI2cCond(1);
+    }
+}
+
+int hostI2cWriteRead(const uint8_t *pTx, int txLen, uint8_t *pRx, int rxLen)
+{
+    int ret = 0;
+    if ((i2cRx != NULL) && (i2cTx != NULL)) {
+        hostI2cCond(0);
+        ret = hostI2cTx(pTx, txLen);
+        if (ret == 0) {
+            hostI2cCond(0);
+            hostI2cRx(pRx, rxLen);
+        }
+        hostI2cCond(1);
+    }
+    return ret;
+}
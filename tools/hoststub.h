@@ -0,0 +1,53 @@
+/** 
+ * @file 	hoststub.h
+ * @author 	Mohit Rathod
+ * Created: 18 10 2026, 02:03:11 pm
+ * -----
+ * Last Modified: 19 10 2026, 12:37:26 am
+ * Modified By  : Mohit Rathod
+ * -----
+ * MIT License
+ * https://opensource.org/licenses/MIT
+ * 
+ * @brief   Host (Linux) stand-ins for the mOS drivers used by the
+ *          portable sources, so the real utils/ and app state
+ *          machines can be linked into host-side tools.
+ */
+#ifndef tools_host_stub_h
+#define tools_host_stub_h
+#include <stdint.h>
+
+/**
+ * @brief   Value returned by mossTicks() on the host.
+ *          Tools set it to drive time explicitly.
+ */
+extern uint16_t hostTicks;
+
+/**
+ * @brief   When non-zero the mOS print functions write to stdout,
+ *          otherwise they are silent.
+ */
+extern int hostVerbose;
+
+/**
+ * @brief   Master side of the stubbed I2C slave, runs the callbacks
+ *          registered with i2cslave_init() as one bus transaction.
+ * @param   pbuf    bytes written by / read into the master.
+ * @param   len     transaction length.
+ * @return  hostI2cWrite: 0, -1 if the slave NACKed a byte.
+ */
+int hostI2cWrite(const uint8_t *pbuf, int len);
+void hostI2cRead(uint8_t *pbuf, int len);
+
+/**
+ * @brief   Write then read in one transaction, with a repeated START in
+ *          between (eg a register read).
+ * @param   pTx     bytes written.
+ * @param   txLen   number of bytes written.
+ * @param   pRx     buffer the bytes are read to.
+ * @param   rxLen   number of bytes read.
+ * @return  0, -1 if the slave NACKed a byte (nothing is read then).
+ */
+int hostI2cWriteRead(const uint8_t *pTx, int txLen, uint8_t *pRx, int rxLen);
+
+#endif /* tools_host_stub_h */
@@ -0,0 +1,260 @@
+/** 
+ * @file 	icscheck.c
+ * @author 	Mohit Rathod
+ * Created: 19 10 2026, 01:02:10 am
+ * -----
+ * Last Modified: 19 10 2026, 12:56:49 am
+ * Modified By  : Mohit Rathod
+ * -----
+ * MIT License
+ * https://opensource.org/licenses/MIT
+ * 
+ * @brief   Host-side checks of the ICS server bus handling. Runs the
+ *          real utils/icsserver.c as a simulated slave (@see
+ *          hoststub.h) through bus sequences a host may produce and
+ *          checks what the server makes of them:
+ *          - a register read with a repeated START after the address,
+ *          - a register write,
+ *          - a bare register address write ended by a STOP, followed
+ *            by a service frame: the frame must reach its service and
+ *            leave the register map alone,
+ *          - multi-byte responses: a run without ICS_commitResponse
+ *            keeps the last snapshot, one updating part of it
+ *            publishes the rest unchanged,
+ *          - completions collected over I2C and ICS_getDone (the SLIP
+ *            transport) alike: each is returned once,
+ *          - a batch whose record removes the service of a later one:
+ *            that record is skipped and flagged, the rest still run,
+ *          - a fragmented transfer over I2C with a fragment of the
+ *            same port sent through ICS_putFrame in between: the
+ *            links keep their own transfer.
+ * 
+ *  Build (from the repository root):
+ *      gcc -std=gnu11 -O2 -I. -ImOS -Iutils -o icscheck tools/icscheck.c \
+ *          tools/hoststub.c utils/icsserver.c utils/crc8.c
+ * 
+ *  Usage:
+ *      icscheck
+ * 
+ *  Returns 0 when every check passes, 1 otherwise.
+ */
+#include <stdio.h>
+#include <utils/crc8.h>
+#include <utils/icsserver.h>
+#include "hoststub.h"
+
+#define REG_RW                  (0x02)
+
+static uint8_t regVar = 0x5A;
+static const icsReg_t regMap[] = {
+    { REG_RW, 1, ICS_REG_RW, &regVar, NULL },
+};
+
+static uint8_t svcArg;
+static uint8_t svcRuns;
+static uint8_t svcLast;
+
+static uint8_t echo(void *pbuf)
+{
+    svcLast = *(uint8_t *)pbuf;
+    svcRuns++;
+    return 0;
+}
+
+static uint8_t rspArg;
+static uint8_t rspBuf[2 * 2];
+
+/**
+ * @brief   Writes its argument to response byte 0, and to byte 1 when
+ *          bit 7 is set. Commits unless the argument is 0.
+ */
+static uint8_t partial(void *pbuf)
+{
+    uint8_t *pRsp = ICS_rspBuffer(PORT_2);
+    pRsp[0] = *(uint8_t *)pbuf;
+    if (pRsp[0] & 0x80) {
+        pRsp[1] = pRsp[0];
+    }
+    if (pRsp[0] != 0) {
+        ICS_commitResponse(PORT_2);
+    }
+    return 0;
+}
+
+static uint8_t fragBuf[6];
+static uint8_t fragRuns;
+
+static uint8_t fragDone(void *pbuf)
+{
+    (void) pbuf;
+    fragRuns++;
+    return 0;
+}
+
+/**
+ * @brief   Fragment seq of a transfer to PORT_0, 3 bytes from pData.
+ */
+static void fragment(uint8_t *pFrame, uint8_t seq, const uint8_t *pData)
+{
+    uint8_t idx;
+    pFrame[0] = ISMP_FRAG_HEADER;
+    pFrame[1] = 6;
+    pFrame[2] = PORT_0;
+    pFrame[3] = seq;
+    pFrame[4] = sizeof(fragBuf);
+    for (idx = 0; idx < 3; idx++) {
+        pFrame[5 + idx] = pData[idx];
+    }
+    pFrame[8] = (uint8_t)computeFCS(pFrame, 8);
+}
+
+/**
+ * @brief   Removes the service of PORT_1.
+ */
+static uint8_t unhook(void *pbuf)
+{
+    (void) pbuf;
+    return (uint8_t)ICS_delService(PORT_1);
+}
+
+static int fails;
+
+static void check(int ok, const char *what)
+{
+    printf("%-44s %s\n", what, ok ? "ok" : "FAIL");
+    if (!ok) {
+        fails++;
+    }
+}
+
+/**
+ * @brief   Service frame to port with one argument.
+ */
+static void send(uint8_t port, uint8_t arg)
+{
+    uint8_t frame[5] = { ISMP_SVC_HEADER, 2, port, arg, 0 };
+    frame[4] = (uint8_t)computeFCS(frame, 4);
+    hostI2cWrite(frame, sizeof(frame));
+}
+
+/**
+ * @brief   Status of the last frame, once the main loop has parsed it.
+ */
+static uint8_t status(void)
+{
+    const uint8_t hdr = ISMP_RSP_HEADER;
+    uint8_t rsp = ISMP_ONGOING;
+    int polls = 4;
+    while ((rsp == ISMP_ONGOING) && (polls-- > 0)) {
+        ICS_run();
+        hostI2cWrite(&hdr, 1);
+        hostI2cRead(&rsp, 1);
+    }
+    return rsp;
+}
+
+int main(void)
+{
+    const uint8_t addr[] = { ISMP_REG_HEADER, REG_RW };
+    const uint8_t wr[] = { ISMP_REG_HEADER, REG_RW, 0xA5 };
+    const uint8_t port2 = PORT_2;
+    const uint8_t doneHdr = ISMP_DONE_HEADER;
+    uint8_t req[6] = { ISMP_REQ_HEADER, 3, PORT_1, 0, 0x5E, 0 };
+    uint8_t batch[9] = { ISMP_BATCH_HEADER, 6, 7, PORT_3, PORT_1, 0x5E,
+                         PORT_2, 0x11, 0 };
+    uint8_t done[3][ISMP_DONE_LEN];
+    uint8_t rsp[3];
+    const uint8_t fragData[] = { 1, 2, 3, 4, 5, 6, 9, 9, 9 };
+    uint8_t frag[9];
+    uint8_t val = 0;
+    uint8_t slip;
+
+    ICSserver_init();
+    ICSi2c_init();
+    ICS_setRegMap(regMap, sizeof(regMap) / sizeof(regMap[0]));
+    ICS_addService(echo, sizeof(svcArg), &svcArg, PORT_1);
+    ICS_addService(partial, sizeof(rspArg), &rspArg, PORT_2);
+    ICS_setResponse(PORT_2, rspBuf, 2);
+    ICS_addService(unhook, 0, NULL, PORT_3);
+    ICS_addService(fragDone, sizeof(fragBuf), fragBuf, PORT_0);
+
+    /* address, repeated START, read */
+    hostI2cWriteRead(addr, sizeof(addr), &val, 1);
+    check(val == 0x5A, "register read after a repeated START");
+
+    hostI2cWrite(wr, sizeof(wr));
+    check(regVar == 0xA5, "register write");
+
+    /* address, STOP: the access ends there */
+    hostI2cWrite(addr, sizeof(addr));
+    send(PORT_1, 0x3C);
+    check(regVar == 0xA5, "frame after an address write, map untouched");
+    check(status() == FRAME_OK, "frame after an address write, FRAME_OK");
+    check((svcRuns == 1) && (svcLast == 0x3C),
+                            "frame after an address write, service ran");
+
+    /* publish 0x91 0x91, then a run without a commit */
+    send(PORT_2, 0x91);
+    status();
+    send(PORT_2, 0);
+    status();
+    hostI2cWrite(&port2, 1);
+    hostI2cRead(rsp, 3);
+    check((rsp[1] == 0x91) && (rsp[2] == 0x91),
+                            "response run without a commit, last kept");
+
+    /* byte 1 of the last snapshot carries over to the next */
+    send(PORT_2, 0x22);
+    status();
+    hostI2cWrite(&port2, 1);
+    hostI2cRead(rsp, 3);
+    check((rsp[1] == 0x22) && (rsp[2] == 0x91),
+                            "response updated in part, rest published");
+
+    /* two requests, one completion collected per link */
+    req[3] = 1;
+    req[5] = (uint8_t)computeFCS(req, 5);
+    hostI2cWrite(req, sizeof(req));
+    status();
+    req[3] = 2;
+    req[5] = (uint8_t)computeFCS(req, 5);
+    hostI2cWrite(req, sizeof(req));
+    status();
+    ICS_run();
+    ICS_getDone(done[0]);
+    hostI2cWrite(&doneHdr, 1);
+    hostI2cRead(done[1], ISMP_DONE_LEN);
+    ICS_getDone(done[2]);
+    check((done[0][1] == 1) && (done[1][1] == 2) && (done[2][0] == 0),
+                            "completions over two links, each once");
+
+    /* record 0 removes the service of record 1, its argument (0x5E)
+     * must not be taken for the port of the next record */
+    svcRuns = 0;
+    batch[8] = (uint8_t)computeFCS(batch, 8);
+    hostI2cWrite(batch, sizeof(batch));
+    status();
+    ICS_getDone(done[0]);
+    hostI2cWrite(&port2, 1);
+    hostI2cRead(rsp, 3);
+    check((svcRuns == 0) && (done[0][0] == ISMP_BATCH_HEADER) &&
+          (done[0][1] == 7) && (done[0][2] == 0x02) && (rsp[1] == 0x11),
+                            "batch with a service removed, rest runs");
+
+    /* I2C sends fragment 0, a fragment 1 through ICS_putFrame isn't
+     * taken for the next of that transfer, which completes over I2C */
+    fragment(frag, 0, &fragData[0]);
+    hostI2cWrite(frag, sizeof(frag));
+    status();
+    fragment(frag, 1, &fragData[6]);
+    slip = ICS_putFrame(frag, sizeof(frag));
+    fragment(frag, 1, &fragData[3]);
+    hostI2cWrite(frag, sizeof(frag));
+    val = status();
+    ICS_run();
+    check((slip == SEQUENCE_ERROR) && (val == FRAME_OK) && (fragRuns == 1) &&
+          (fragBuf[3] == 4) && (fragBuf[5] == 6),
+                            "fragments of two links kept apart");
+
+    return (fails == 0) ? 0 : 1;
+}
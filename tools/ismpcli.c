@@ -0,0 +1,358 @@
+/** 
+ * @file 	ismpcli.c
+ * @author 	Mohit Rathod
+ * Created: 19 10 2026, 12:14:52 am
+ * -----
+ * Last Modified: 19 10 2026, 12:39:05 am
+ * Modified By  : Mohit Rathod
+ * -----
+ * MIT License
+ * https://opensource.org/licenses/MIT
+ * 
+ * @brief   ISMP command line client and load generator.
+ *          Talks to an ICS server behind /dev/i2c-N, or to the real
+ *          utils/icsserver.c linked in as a simulated slave with the
+ *          demo services below.
+ * 
+ *  Build (from the repository root):
+ *      gcc -std=gnu11 -O2 -I. -ImOS -Iutils -o ismpcli tools/ismpcli.c \
+ *          tools/ismpclient.c tools/hoststub.c utils/icsserver.c utils/crc8.c
+ * 
+ *  Usage:
+ *      ismpcli [-d dev] [-a addr] [-j k] <command>
+ *      -d dev      i2c-dev adapter, eg /dev/i2c-1 (default: simulated)
+ *      -a addr     server address (default 0x40)
+ *      -j k        simulated slave runs ICS_run every k transactions,
+ *                  k > 1 models a main loop that lags the bus (default 1)
+ * 
+ *      send <port> [byte..]        service frame, prints the status
+ *      req <port> <id> [byte..]    request frame, prints the status
+ *      read <port> [n]             reads n response bytes (default 1)
+ *      done                        reads the oldest completion
+ *      info                        reads the server descriptor
+ *      stats                       reads the mOS statistics block
+ *                                  (@see mosstat.h), a device only
+ *      load [-n num] [-p port] [-l len] [-c pct] [-i]
+ *                                  num frames (default 10000) of len
+ *                                  random args (default: as the
+ *                                  server descriptor says) to port
+ *                                  (default PORT_1), pct % sent with a
+ *                                  bad CRC, -i as request frames.
+ *                                  Reports requests/s, latency
+ *                                  percentiles and the status counts.
+ * 
+ *  Simulated services: PORT_0 no args, returns a run count. PORT_1
+ *  1 arg, returns it doubled. PORT_2 3 args, returns their sum with a
+ *  2 byte response of the run count.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <utils/crc8.h>
+#include <utils/icsserver.h>
+#include <mosstat.h>
+#include "ismpclient.h"
+
+#define STATUS_POLLS            (64)
+
+static uint8_t simRuns;
+static uint8_t simArgs1[1];
+static uint8_t simArgs2[3];
+static uint8_t simRsp2[2 * 2];
+
+static uint8_t simPort0(void *pargs)
+{
+    (void) pargs;
+    return ++simRuns;
+}
+
+static uint8_t simPort1(void *pargs)
+{
+    return (uint8_t)(((uint8_t *)pargs)[0] * 2);
+}
+
+static uint8_t simPort2(void *pargs)
+{
+    const uint8_t *args = pargs;
+    uint8_t *rsp = ICS_rspBuffer(PORT_2);
+    simRuns++;
+    rsp[0] = simRuns;
+    rsp[1] = 0;
+    ICS_commitResponse(PORT_2);
+    return (uint8_t)(args[0] + args[1] + args[2]);
+}
+
+static void simServices(void)
+{
+    ICS_addService(simPort0, 0, NULL, PORT_0);
+    ICS_addService(simPort1, 1, simArgs1, PORT_1);
+    ICS_addService(simPort2, 3, simArgs2, PORT_2);
+    ICS_setResponse(PORT_2, simRsp2, 2);
+}
+
+static double now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static int cmpDouble(const void *a, const void *b)
+{
+    double d = *(const double *)a - *(const double *)b;
+    return (d > 0) - (d < 0);
+}
+
+static int parseBytes(char **argv, int argc, uint8_t *pbuf, int max)
+{
+    int idx;
+    for (idx = 0; (idx < argc) && (idx < max); idx++) {
+        pbuf[idx] = (uint8_t)strtoul(argv[idx], NULL, 0);
+    }
+    return idx;
+}
+
+static int load(ismpLink_t *pLink, int argc, char **argv)
+{
+    static unsigned counts[256];
+    unsigned num = 10000, idx, errs = 0, nacks = 0;
+    uint8_t port = PORT_1, len = 0xFF, req = 0;
+    ismpInfo_t info;
+    unsigned pct = 0;
+    uint8_t data[MAX_PAYLOAD_LEN];
+    uint8_t frame[MAX_PAYLOAD_LEN + 4];
+    double *lat;
+    double t0, t1, start;
+    int arg, flen, rsp;
+
+    for (arg = 0; arg < argc; arg++) {
+        if ((strcmp(argv[arg], "-n") == 0) && (arg + 1 < argc)) {
+            num = strtoul(argv[++arg], NULL, 0);
+        } else if ((strcmp(argv[arg], "-p") == 0) && (arg + 1 < argc)) {
+            port = strtoul(argv[++arg], NULL, 0);
+        } else if ((strcmp(argv[arg], "-l") == 0) && (arg + 1 < argc)) {
+            len = strtoul(argv[++arg], NULL, 0);
+        } else if ((strcmp(argv[arg], "-c") == 0) && (arg + 1 < argc)) {
+            pct = strtoul(argv[++arg], NULL, 0);
+        } else if (strcmp(argv[arg], "-i") == 0) {
+            req = 1;
+        }
+    }
+    /* size the frames from the descriptor */
+    if ((len == 0xFF) && (ismpGetInfo(pLink, &info) == 0) &&
+        (port >= PORT_0) && (port < PORT_0 + info.ports)) {
+        len = info.port[port - PORT_0].argLen;
+    }
+    if ((num == 0) || (len > MAX_PAYLOAD_LEN - 1)) {
+        fprintf(stderr, "load: bad frame count or length\n");
+        return 2;
+    }
+    lat = malloc(num * sizeof(*lat));
+    if (lat == NULL) {
+        return 2;
+    }
+    srand(1);
+    start = now();
+    for (idx = 0; idx < num; idx++) {
+        data[0] = (uint8_t)idx;
+        for (arg = req; arg < len + req; arg++) {
+            data[arg] = (uint8_t)rand();
+        }
+        flen = ismpBuild(frame, req ? ISMP_REQ_HEADER : ISMP_SVC_HEADER,
+                                                    port, data, len + req);
+        if ((unsigned)(rand() % 100) < pct) {
+            frame[flen - 1] ^= 0x01;
+        }
+        t0 = now();
+        rsp = ismpSend(pLink, frame, flen, STATUS_POLLS);
+        t1 = now();
+        lat[idx] = (t1 - t0) * 1e6;
+        if (rsp == ISMP_NACKED) {
+            nacks++;
+        } else if (rsp < 0) {
+            errs++;
+        } else {
+            counts[rsp]++;
+        }
+        /* collect the completions so the queue doesn't block */
+        if (req) {
+            uint8_t hdr = ISMP_DONE_HEADER, rec[ISMP_DONE_LEN];
+            ismpWrite(pLink, &hdr, 1);
+            ismpRead(pLink, rec, sizeof(rec));
+        }
+    }
+    t1 = now();
+    qsort(lat, num, sizeof(*lat), cmpDouble);
+
+    printf("frames        %u (%u bytes each, %u%% bad CRC)\n", num, flen, pct);
+    printf("transactions  %u\n", pLink->xfers);
+    printf("elapsed       %.3f s\n", t1 - start);
+    printf("requests/s    %.1f\n", num / (t1 - start));
+    printf("latency us    p50 %.1f  p90 %.1f  p99 %.1f  max %.1f\n",
+            lat[num / 2], lat[(num * 9) / 10], lat[(num * 99) / 100],
+            lat[num - 1]);
+    printf("status\n");
+    for (arg = 0; arg < 256; arg++) {
+        if (counts[arg] != 0) {
+            printf("  %-20s %u\n", ismpRspName(arg), counts[arg]);
+        }
+    }
+    if (nacks != 0) {
+        printf("  %-20s %u\n", "NACKed", nacks);
+    }
+    if (errs != 0) {
+        printf("  %-20s %u\n", "link errors", errs);
+    }
+    free(lat);
+    return 0;
+}
+
+static unsigned get16(const uint8_t *p)
+{
+    return p[0] | (p[1] << 8);
+}
+
+/**
+ * @brief   Run the statistics service, read and print the block.
+ */
+static int stats(ismpLink_t *pLink)
+{
+    static const char *const frames[ICS_STAT_NUM] = {
+        "ok", "busy", "header", "crc", "size", "params", "srvc",
+        "port", "seq", "dropped"
+    };
+    uint8_t frame[4];
+    uint8_t buf[MOSSTAT_LEN + 2];
+    const uint8_t *p = &buf[1];
+    int idx, rsp;
+    rsp = ismpSend(pLink, frame, ismpBuild(frame, ISMP_SVC_HEADER,
+                                    MOSSTAT_PORT, NULL, 0), STATUS_POLLS);
+    if (rsp != FRAME_OK) {
+        printf("%s\n", (rsp == ISMP_NACKED) ? "NACKed" :
+                        (rsp < 0) ? "link error" : ismpRspName(rsp));
+        return 1;
+    }
+    /* the response only changes once the service has run */
+    for (idx = 0; idx < STATUS_POLLS; idx++) {
+        if (ismpReadPort(pLink, MOSSTAT_PORT, buf, sizeof(buf)) != 0) {
+            return 1;
+        }
+        if ((computeFCS(buf, sizeof(buf)) == 0) && (buf[1] != 0)) {
+            break;
+        }
+    }
+    if ((idx == STATUS_POLLS) || (p[0] != MOSSTAT_VERSION)) {
+        printf("no statistics\n");
+        return 1;
+    }
+    printf("uptime      %lu s\n", (unsigned long)get16(&p[1]) |
+                                    ((unsigned long)get16(&p[3]) << 16));
+    printf("loops/s     %lu\n", (unsigned long)get16(&p[5]) |
+                                    ((unsigned long)get16(&p[7]) << 16));
+    printf("overruns    %u\n", get16(&p[9]));
+    printf("wdt resets  %u\n", p[11]);
+    printf("stack       %u bytes\n", get16(&p[12]));
+    p += 14;
+    printf("queue drops");
+    for (idx = *p++; idx > 0; idx--, p += 2) {
+        printf(" %u", get16(p));
+    }
+    printf("\nframes\n");
+    for (idx = 0; idx < ICS_STAT_NUM; idx++, p += 2) {
+        printf("  %-10s %u\n", frames[idx], get16(p));
+    }
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    ismpLink_t link;
+    const char *dev = NULL;
+    uint8_t addr = ICS_SERVER_ADDRESS;
+    unsigned runEvery = 1;
+    uint8_t buf[32];
+    uint8_t frame[MAX_PAYLOAD_LEN + 4];
+    int arg = 1, len, rsp, ret = 0;
+
+    while ((arg < argc) && (argv[arg][0] == '-')) {
+        if ((strcmp(argv[arg], "-d") == 0) && (arg + 1 < argc)) {
+            dev = argv[++arg];
+        } else if ((strcmp(argv[arg], "-a") == 0) && (arg + 1 < argc)) {
+            addr = strtoul(argv[++arg], NULL, 0);
+        } else if ((strcmp(argv[arg], "-j") == 0) && (arg + 1 < argc)) {
+            runEvery = strtoul(argv[++arg], NULL, 0);
+        } else {
+            break;
+        }
+        arg++;
+    }
+    if (arg >= argc) {
+        fprintf(stderr, "usage: %s [-d dev] [-a addr] [-j k] "
+                "send|req|read|done|info|stats|load ...\n", argv[0]);
+        return 2;
+    }
+    if (ismpOpen(&link, dev, addr) != 0) {
+        return 2;
+    }
+    link.runEvery = runEvery;
+    if (dev == NULL) {
+        simServices();
+    }
+
+    if ((strcmp(argv[arg], "send") == 0) && (arg + 1 < argc)) {
+        len = parseBytes(&argv[arg + 2], argc - arg - 2, buf, MAX_PAYLOAD_LEN - 1);
+        len = ismpBuild(frame, ISMP_SVC_HEADER,
+                        strtoul(argv[arg + 1], NULL, 0), buf, len);
+        rsp = ismpSend(&link, frame, len, STATUS_POLLS);
+        printf("%s\n", (rsp == ISMP_NACKED) ? "NACKed" :
+                        (rsp < 0) ? "link error" : ismpRspName(rsp));
+        ret = (rsp == FRAME_OK) ? 0 : 1;
+    } else if ((strcmp(argv[arg], "req") == 0) && (arg + 2 < argc)) {
+        len = parseBytes(&argv[arg + 2], argc - arg - 2, buf, MAX_PAYLOAD_LEN - 1);
+        len = ismpBuild(frame, ISMP_REQ_HEADER,
+                        strtoul(argv[arg + 1], NULL, 0), buf, len);
+        rsp = ismpSend(&link, frame, len, STATUS_POLLS);
+        printf("%s\n", (rsp == ISMP_NACKED) ? "NACKed" :
+                        (rsp < 0) ? "link error" : ismpRspName(rsp));
+        ret = (rsp == FRAME_OK) ? 0 : 1;
+    } else if ((strcmp(argv[arg], "read") == 0) && (arg + 1 < argc)) {
+        len = (arg + 2 < argc) ? atoi(argv[arg + 2]) : 1;
+        len = (len < 1) ? 1 : (len > (int)sizeof(buf)) ? (int)sizeof(buf) : len;
+        ret = ismpReadPort(&link, strtoul(argv[arg + 1], NULL, 0), buf, len);
+        for (rsp = 0; (ret == 0) && (rsp < len); rsp++) {
+            printf("%02X ", buf[rsp]);
+        }
+        printf("\n");
+    } else if (strcmp(argv[arg], "done") == 0) {
+        buf[0] = ISMP_DONE_HEADER;
+        ret = ismpWrite(&link, buf, 1) || ismpRead(&link, buf, ISMP_DONE_LEN);
+        printf("port 0x%02X id %u response 0x%02X\n", buf[0], buf[1], buf[2]);
+    } else if (strcmp(argv[arg], "info") == 0) {
+        ismpInfo_t info;
+        ret = ismpGetInfo(&link, &info);
+        if (ret == 0) {
+            printf("version %u, payload %u, fragment %u, batch %u, %u ports\n",
+                    info.version, info.maxPayload, info.fragLen,
+                    info.batchLen, info.ports);
+            for (rsp = 0; rsp < info.ports; rsp++) {
+                printf("  0x%02X args %3u rsp %3u %s%s%s\n", PORT_0 + rsp,
+                        info.port[rsp].argLen, info.port[rsp].rspLen,
+                        (info.port[rsp].flags & ISMP_PORT_ACTIVE) ? "active" : "-",
+                        (info.port[rsp].flags & ISMP_PORT_FRAG) ? " frag" : "",
+                        (info.port[rsp].flags & ISMP_PORT_BUF2) ? " buf2" : "");
+            }
+        } else {
+            printf("no descriptor\n");
+        }
+    } else if (strcmp(argv[arg], "stats") == 0) {
+        ret = stats(&link);
+    } else if (strcmp(argv[arg], "load") == 0) {
+        ret = load(&link, argc - arg - 1, &argv[arg + 1]);
+    } else {
+        fprintf(stderr, "%s: unknown command %s\n", argv[0], argv[arg]);
+        ret = 2;
+    }
+    ismpClose(&link);
+    return ret;
+}
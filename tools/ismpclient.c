@@ -0,0 +1,185 @@
+/** 
+ * @file 	ismpclient.c
+ * @author 	Mohit Rathod
+ * Created: 19 10 2026, 12:14:52 am
+ * -----
+ * Last Modified: 19 10 2026, 12:56:49 am
+ * Modified By  : Mohit Rathod
+ * -----
+ * MIT License
+ * https://opensource.org/licenses/MIT
+ * 
+ * @brief   Host (Linux) ISMP client.
+ * 
+ */
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <linux/i2c-dev.h>
+#include <utils/crc8.h>
+#include <utils/icsserver.h>
+#include "hoststub.h"
+#include "ismpclient.h"
+
+int ismpOpen(ismpLink_t *pLink, const char *dev, uint8_t addr)
+{
+    int ret = -1;
+    if (pLink != NULL) {
+        memset(pLink, 0, sizeof(*pLink));
+        pLink->fd = -1;
+        pLink->runEvery = 1;
+        if (dev == NULL) {
+            ret = ICSserver_init();
+            if (ret == 0) {
+                ret = ICSi2c_init();
+            }
+        } else {
+            pLink->fd = open(dev, O_RDWR);
+            if (pLink->fd < 0) {
+                perror(dev);
+            } else if (ioctl(pLink->fd, I2C_SLAVE, addr) < 0) {
+                perror("I2C_SLAVE");
+                close(pLink->fd);
+                pLink->fd = -1;
+            } else {
+                ret = 0;
+            }
+        }
+    }
+    return ret;
+}
+
+void ismpClose(ismpLink_t *pLink)
+{
+    if (pLink->fd >= 0) {
+        close(pLink->fd);
+        pLink->fd = -1;
+    }
+}
+
+/**
+ * @brief   The simulated slave's main loop gets a turn every runEvery
+ *          transactions, before the transaction.
+ */
+static void simLoop(ismpLink_t *pLink)
+{
+    if ((pLink->runEvery != 0) && ((pLink->xfers % pLink->runEvery) == 0)) {
+        ICS_run();
+    }
+    pLink->xfers++;
+}
+
+int ismpWrite(ismpLink_t *pLink, const uint8_t *pbuf, int len)
+{
+    int ret = 0;
+    if (pLink->fd < 0) {
+        simLoop(pLink);
+        ret = (hostI2cWrite(pbuf, len) == 0) ? 0 : ISMP_NACKED;
+    } else {
+        pLink->xfers++;
+        if (write(pLink->fd, pbuf, len) != len) {
+            /* i2c-dev reports a NACK after the address as EREMOTEIO */
+            ret = (errno == EREMOTEIO) ? ISMP_NACKED : -1;
+        }
+    }
+    return ret;
+}
+
+int ismpRead(ismpLink_t *pLink, uint8_t *pbuf, int len)
+{
+    int ret = 0;
+    if (pLink->fd < 0) {
+        simLoop(pLink);
+        hostI2cRead(pbuf, len);
+    } else {
+        pLink->xfers++;
+        ret = (read(pLink->fd, pbuf, len) == len) ? 0 : -1;
+    }
+    return ret;
+}
+
+int ismpBuild(uint8_t *pFrame, uint8_t header, uint8_t port,
+                                        const uint8_t *pData, uint8_t len)
+{
+    pFrame[0] = header;
+    pFrame[1] = len + 1;
+    pFrame[2] = port;
+    if (len != 0) {
+        memcpy(&pFrame[3], pData, len);
+    }
+    pFrame[3 + len] = (uint8_t)computeFCS(pFrame, 3 + len);
+    return 4 + len;
+}
+
+int ismpSend(ismpLink_t *pLink, const uint8_t *pFrame, int len, int polls)
+{
+    const uint8_t hdr = ISMP_RSP_HEADER;
+    uint8_t rsp = ISMP_ONGOING;
+    int ret = ismpWrite(pLink, pFrame, len);
+    if (ret == 0) {
+        while ((rsp == ISMP_ONGOING) && (polls-- > 0)) {
+            if ((ismpWrite(pLink, &hdr, 1) != 0) ||
+                (ismpRead(pLink, &rsp, 1) != 0)) {
+                return -1;
+            }
+        }
+        ret = rsp;
+    }
+    return ret;
+}
+
+int ismpReadPort(ismpLink_t *pLink, uint8_t port, uint8_t *pRsp, int len)
+{
+    int ret = -1;
+    if (ismpWrite(pLink, &port, 1) == 0) {
+        ret = ismpRead(pLink, pRsp, len);
+    }
+    return ret;
+}
+
+int ismpGetInfo(ismpLink_t *pLink, ismpInfo_t *pInfo)
+{
+    const uint8_t hdr = ISMP_VERSION;
+    uint8_t buf[ISMP_INFO_LEN(PORT_MAX - PORT_0) + 1];
+    int ret = -1;
+    int len;
+    /* the header first, it says how many ports follow */
+    if ((ismpWrite(pLink, &hdr, 1) == 0) &&
+        (ismpRead(pLink, buf, ISMP_INFO_LEN(0)) == 0) &&
+        (buf[4] <= (PORT_MAX - PORT_0))) {
+        len = ISMP_INFO_LEN(buf[4]) + 1;
+        if ((ismpWrite(pLink, &hdr, 1) == 0) &&
+            (ismpRead(pLink, buf, len) == 0) &&
+            (computeFCS(buf, len) == 0)) {
+            memset(pInfo, 0, sizeof(*pInfo));
+            memcpy(pInfo, buf, ISMP_INFO_LEN(buf[4]));
+            ret = 0;
+        }
+    }
+    return ret;
+}
+
+const char *ismpRspName(int rsp)
+{
+    static char hex[8];
+    switch (rsp) {
+    case FRAME_OK:              return "FRAME_OK";
+    case FRAME_OK_SRVC_BUSY:    return "FRAME_OK_SRVC_BUSY";
+    case HEADER_ERROR:          return "HEADER_ERROR";
+    case CHECKSUM_ERROR:        return "CHECKSUM_ERROR";
+    case FRAME_SIZE_ERROR:      return "FRAME_SIZE_ERROR";
+    case INVALID_PARAMS:        return "INVALID_PARAMS";
+    case INVALID_SRVC:          return "INVALID_SRVC";
+    case INVALID_PORT:          return "INVALID_PORT";
+    case ISMP_ONGOING:          return "ISMP_ONGOING";
+    case UNKNOWN_ERROR:         return "UNKNOWN_ERROR";
+    case UNKNOWN_RESP:          return "UNKNOWN_RESP";
+    case SEQUENCE_ERROR:        return "SEQUENCE_ERROR";
+    default:
+        snprintf(hex, sizeof(hex), "0x%02X", rsp & 0xFF);
+        return hex;
+    }
+}
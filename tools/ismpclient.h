@@ -0,0 +1,150 @@
+/** 
+ * @file 	ismpclient.h
+ * @author 	Mohit Rathod
+ * Created: 19 10 2026, 12:14:52 am
+ * -----
+ * Last Modified: 19 10 2026, 12:13:46 am
+ * Modified By  : Mohit Rathod
+ * -----
+ * MIT License
+ * https://opensource.org/licenses/MIT
+ * 
+ * @brief   Host (Linux) ISMP client. Builds ISMP frames and exchanges
+ *          them with an ICS server, either a device behind a Linux
+ *          i2c-dev adapter (/dev/i2c-N) or the real utils/icsserver.c
+ *          linked in as a simulated slave (@see hoststub.h).
+ */
+#ifndef tools_ismp_client_h
+#define tools_ismp_client_h
+#include <stdint.h>
+#include <utils/ismpframe.h>
+
+/* Returned when the server refused a write (flow control) */
+#define ISMP_NACKED             (-2)
+
+/**
+ * @brief   Link to an ICS server.
+ */
+typedef struct
+{
+    int fd;                 /* i2c-dev file, -1 for the simulated slave */
+    unsigned runEvery;      /* simulated slave: transactions per ICS_run */
+    unsigned xfers;         /* transactions so far */
+} ismpLink_t;
+
+/**
+ * @brief   Server descriptor, @see ISMP_VERSION.
+ */
+typedef struct
+{
+    uint8_t version;
+    uint8_t maxPayload;
+    uint8_t fragLen;
+    uint8_t batchLen;
+    uint8_t ports;
+    struct
+    {
+        uint8_t argLen;
+        uint8_t rspLen;
+        uint8_t flags;
+    } port[PORT_MAX - PORT_0];
+} ismpInfo_t;
+
+/**
+ * @fn      int ismpOpen(ismpLink_t *, const char *, uint8_t);
+ * @brief   Open a link to an ICS server.
+ * @param   pLink   link to open.
+ * @param   dev     i2c-dev adapter, eg "/dev/i2c-1", NULL for the
+ *                  simulated slave (ICSserver_init is called, the
+ *                  services are left to the caller).
+ * @param   addr    7 bit address of the server.
+ * @return  0 on success, -1 otherwise
+ */
+int ismpOpen(ismpLink_t *pLink, const char *dev, uint8_t addr);
+
+/**
+ * @fn      void ismpClose(ismpLink_t *pLink);
+ * @brief   Close a link.
+ * @param   pLink   the link.
+ */
+void ismpClose(ismpLink_t *pLink);
+
+/**
+ * @fn      int ismpWrite(ismpLink_t *, const uint8_t *, int);
+ * @brief   Write bytes to the server in one transaction.
+ * @param   pLink   the link.
+ * @param   pbuf    bytes to write.
+ * @param   len     number of bytes.
+ * @return  0 on success, ISMP_NACKED if the server refused a byte,
+ *          -1 otherwise
+ */
+int ismpWrite(ismpLink_t *pLink, const uint8_t *pbuf, int len);
+
+/**
+ * @fn      int ismpRead(ismpLink_t *, uint8_t *, int);
+ * @brief   Read bytes from the server in one transaction.
+ * @param   pLink   the link.
+ * @param   pbuf    buffer to read into.
+ * @param   len     number of bytes.
+ * @return  0 on success, -1 otherwise
+ */
+int ismpRead(ismpLink_t *pLink, uint8_t *pbuf, int len);
+
+/**
+ * @fn      int ismpBuild(uint8_t *, uint8_t, uint8_t, const uint8_t *, uint8_t);
+ * @brief   Build a frame |Header|Len|Port|Data..|CRC|. The data of a
+ *          request frame starts with its ID, that of a fragment with
+ *          its Seq and Total.
+ * @param   pFrame  buffer of len + 4 bytes.
+ * @param   header  ISMP_SVC_HEADER, ISMP_REQ_HEADER or ISMP_FRAG_HEADER.
+ * @param   port    service port.
+ * @param   pData   data bytes (may be NULL when len is 0).
+ * @param   len     number of data bytes.
+ * @return  frame length.
+ */
+int ismpBuild(uint8_t *pFrame, uint8_t header, uint8_t port,
+                                        const uint8_t *pData, uint8_t len);
+
+/**
+ * @fn      int ismpSend(ismpLink_t *, const uint8_t *, int, int);
+ * @brief   Send a frame and read its status (ISMP_RSP_HEADER), read
+ *          again while the server reports ISMP_ONGOING.
+ * @param   pLink   the link.
+ * @param   pFrame  the frame.
+ * @param   len     frame length.
+ * @param   polls   max. status reads.
+ * @return  status byte, ISMP_NACKED if the server refused the frame,
+ *          -1 on a link error.
+ */
+int ismpSend(ismpLink_t *pLink, const uint8_t *pFrame, int len, int polls);
+
+/**
+ * @fn      int ismpReadPort(ismpLink_t *, uint8_t, uint8_t *, int);
+ * @brief   Read the response of a port: return value, multi-byte
+ *          response and, if len covers it, the trailing CRC.
+ * @param   pLink   the link.
+ * @param   port    service port.
+ * @param   pRsp    buffer to read into.
+ * @param   len     number of bytes to read.
+ * @return  0 on success, -1 otherwise
+ */
+int ismpReadPort(ismpLink_t *pLink, uint8_t port, uint8_t *pRsp, int len);
+
+/**
+ * @fn      int ismpGetInfo(ismpLink_t *pLink, ismpInfo_t *pInfo);
+ * @brief   Read and check the server descriptor.
+ * @param   pLink   the link.
+ * @param   pInfo   descriptor to fill.
+ * @return  0 on success, -1 on a link or CRC error.
+ */
+int ismpGetInfo(ismpLink_t *pLink, ismpInfo_t *pInfo);
+
+/**
+ * @fn      const char *ismpRspName(int rsp);
+ * @brief   Name of an ISMPresponse_t value.
+ * @param   rsp     the value.
+ * @return  name, "0x.." for values without one.
+ */
+const char *ismpRspName(int rsp);
+
+#endif /* tools_ismp_client_h */
@@ -0,0 +1,125 @@
+/** 
+ * @file 	smfbench.c
+ * @author 	Mohit Rathod
+ * Created: 18 10 2026, 03:40:18 pm
+ * -----
+ * Last Modified: 18 10 2026, 03:40:18 pm
+ * Modified By  : Mohit Rathod
+ * -----
+ * MIT License
+ * https://opensource.org/licenses/MIT
+ * 
+ * @brief   Host benchmark of the dynamic SMF transition table.
+ *          Reports lookup time and table memory of the dense and
+ *          sparse layouts of utils/smfdyn.c for machines up to
+ *          64 states x 32 events.
+ * 
+ *  Build both layouts (from the repository root):
+ *      gcc -std=gnu11 -O2 -I. -ImOS -DSMF_DYN_SPARSE=0 -o smfbench_dense \
+ *          tools/smfbench.c utils/smfdyn.c utils/queue.c
+ *      gcc -std=gnu11 -O2 -I. -ImOS -DSMF_DYN_SPARSE=1 -o smfbench_sparse \
+ *          tools/smfbench.c utils/smfdyn.c utils/queue.c
+ * 
+ *  Usage:
+ *      smfbench [transitions per state]    (default 3)
+ * 
+ *  "host B" is the heap used on the host, "msp430 B" the same table
+ *  with the 2 byte pointers of the target (allocator overhead aside).
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <utils/smfdyn.h>
+
+#ifndef SMF_DYN_SPARSE
+#define SMF_DYN_SPARSE          MOS_USES(SMF_SPARSE)
+#endif
+
+#define LOOKUPS                 (1u << 22)
+
+static state_t action(void *pCtx)
+{
+    (void) pCtx;
+    return STATE_0;
+}
+
+static double now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static void bench(uint8_t stateNUM, uint8_t eventNUM, unsigned perState)
+{
+    static evAction_t pairs[32];
+    static uint8_t query[LOOKUPS][2];
+    dsmTable_t *pTable;
+    unsigned st, ev, idx, num = 0, hits = 0;
+    size_t target;
+    double t0, t1;
+
+    if (perState > eventNUM) {
+        perState = eventNUM;
+    }
+    if (dSMF_tableInit(&pTable, stateNUM, eventNUM) != 0) {
+        fprintf(stderr, "table allocation failed\n");
+        exit(1);
+    }
+    /* perState distinct random events for every state */
+    for (st = 0; st < stateNUM; st++) {
+        uint32_t used = 0;
+        stateTransition_t trans = { pairs, perState };
+        for (idx = 0; idx < perState; idx++) {
+            do {
+                ev = rand() % eventNUM;
+            } while (used & (1u << ev));
+            used |= 1u << ev;
+            pairs[idx].event = (event_t)(EVENT_0 + ev);
+            pairs[idx].action = action;
+        }
+        dSMF_addState(pTable, (state_t)(STATE_0 + st), &trans);
+        num += perState;
+    }
+    for (idx = 0; idx < LOOKUPS; idx++) {
+        query[idx][0] = rand() % stateNUM;
+        query[idx][1] = rand() % eventNUM;
+    }
+
+    t0 = now();
+    for (idx = 0; idx < LOOKUPS; idx++) {
+        if (dSMF_getAction(pTable, (state_t)(STATE_0 + query[idx][0]),
+                            (event_t)(EVENT_0 + query[idx][1])) != NULL) {
+            hits++;
+        }
+    }
+    t1 = now();
+
+#if SMF_DYN_SPARSE
+    /* header, a row (pointer + len) per state, entry (event + pointer) */
+    target = 2 + stateNUM * 4 + num * 4;
+#else
+    /* header, a pointer per (state, event) pair */
+    target = 2 + stateNUM * eventNUM * 2;
+#endif
+    printf("%-6s %3u x %-3u %5u %8zu %9zu %9.2f   (%u hits)\n",
+            SMF_DYN_SPARSE ? "sparse" : "dense", stateNUM, eventNUM, num,
+            dSMF_tableSize(pTable), target,
+            (t1 - t0) * 1e9 / LOOKUPS, hits);
+}
+
+int main(int argc, char *argv[])
+{
+    static const uint8_t sizes[][2] = {
+        {8, 4}, {8, 8}, {16, 8}, {16, 16}, {32, 16}, {32, 32}, {64, 32}
+    };
+    unsigned perState = (argc > 1) ? (unsigned)atoi(argv[1]) : 3;
+    unsigned idx;
+
+    srand(1);
+    printf("layout  size    trans   host B  msp430 B  ns/lookup\n");
+    for (idx = 0; idx < sizeof(sizes) / sizeof(sizes[0]); idx++) {
+        bench(sizes[idx][0], sizes[idx][1], perState);
+    }
+    return 0;
+}
@@ -0,0 +1,224 @@
+/** 
+ * @file 	smfcheck.c
+ * @author 	Mohit Rathod
+ * Created: 18 10 2026, 04:40:12 pm
+ * -----
+ * Last Modified: 19 10 2026, 12:51:46 am
+ * Modified By  : Mohit Rathod
+ * -----
+ * MIT License
+ * https://opensource.org/licenses/MIT
+ * 
+ * @brief   Host-side model checker of the sunroof state machine.
+ *          Explores every (state, event) pair reachable from the
+ *          initial state of the table registered in setup(), running
+ *          the real actions against the driver stubs, and reports:
+ *          - actions returning an invalid state,
+ *          - states that can't be reached from the initial state,
+ *          - events not handled in a reachable state (info only),
+ *          - timeouts whose event isn't handled in their state,
+ *          - states that can't reach SUNROOF_STOP_STATE, split in
+ *            dead ends and cycles without a stop path.
+ *          It then measures the transition throughput of utils/smf.c
+ *          with a random walk over the handled events.
+ * 
+ *  Build (from the repository root):
+ *      gcc -std=gnu11 -O2 -I. -ImOS -Iutils -o smfcheck tools/smfcheck.c \
+ *          tools/hoststub.c sunroof.c utils/smf.c utils/queue.c \
+ *          utils/slip.c utils/icsserver.c utils/crc8.c
+ * 
+ *  Usage:
+ *      smfcheck [transitions]      (default 1000000)
+ * 
+ *  Returns 0 when no error is found, 1 otherwise.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <utils/smf.h>
+#include "hoststub.h"
+#include "sunroof.h"
+#include "smfnames.h"
+
+#define STATE_BIT(s)            (1u << ((s) - STATE_0))
+
+/* successors of every state, bit n set => STATE_0 + n */
+static uint16_t succ[STATESMAX];
+
+static double now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/**
+ * @brief   Next state of a (state, event) pair, the current state when
+ *          the event isn't handled.
+ * @return  the next state, 0 if the action returned an invalid state.
+ */
+static state_t nextState(const smfTable_t *pTable, state_t uState,
+                                                        event_t uEvent)
+{
+    pAction_t action = SMF_getAction(pTable, uState, uEvent);
+    state_t nxt = uState;
+    if (action != NULL) {
+        nxt = action(NULL);
+        if ((nxt < STATE_0) || (nxt >= MAX_States)) {
+            nxt = (state_t)0;
+        }
+    }
+    return nxt;
+}
+
+/**
+ * @brief   Breadth-first exploration from iState, fills succ[].
+ * @return  bitmask of the reachable states.
+ */
+static uint16_t explore(const smfTable_t *pTable, state_t iState,
+                                                    unsigned *pErrors)
+{
+    state_t fifo[STATESMAX];
+    unsigned head = 0, tail = 0;
+    uint16_t seen = STATE_BIT(iState);
+    fifo[tail++] = iState;
+    while (head < tail) {
+        state_t cur = fifo[head++];
+        unsigned ev;
+        for (ev = EVENT_0; ev < MAX_Events; ev++) {
+            state_t nxt = nextState(pTable, cur, (event_t)ev);
+            if (nxt == 0) {
+                printf("ERROR  %s --%s--> invalid state\n",
+                        stateName(cur), eventName(ev));
+                (*pErrors)++;
+                continue;
+            }
+            succ[cur - STATE_0] |= STATE_BIT(nxt);
+            if (!(seen & STATE_BIT(nxt))) {
+                seen |= STATE_BIT(nxt);
+                fifo[tail++] = nxt;
+            }
+        }
+    }
+    return seen;
+}
+
+/**
+ * @brief   Transitive closure of succ[], reach[n] holds the states
+ *          reachable from STATE_0 + n in one or more transitions.
+ */
+static void closure(uint16_t reach[STATESMAX])
+{
+    unsigned s, t;
+    int changed = 1;
+    for (s = 0; s < STATESMAX; s++) {
+        reach[s] = succ[s];
+    }
+    while (changed) {
+        changed = 0;
+        for (s = 0; s < STATESMAX; s++) {
+            uint16_t next = reach[s];
+            for (t = 0; t < STATESMAX; t++) {
+                if (reach[s] & (1u << t)) {
+                    next |= reach[t];
+                }
+            }
+            if (next != reach[s]) {
+                reach[s] = next;
+                changed = 1;
+            }
+        }
+    }
+}
+
+/**
+ * @brief   Random walk over the handled events of the real framework.
+ *          *pNum is cut short if the walk gets stuck in a dead end.
+ * @return  transitions per second.
+ */
+static double throughput(const smfTable_t *pTable, state_t iState,
+                                                        unsigned *pNum)
+{
+    unsigned num = *pNum;
+    static smf_t sm;
+    unsigned idx;
+    double t0, t1;
+
+    if (SMF_init(&sm, pTable, iState, NULL) != 0) {
+        return 0;
+    }
+    srand(1);
+    t0 = now();
+    for (idx = 0; idx < num; idx++) {
+        state_t cur = SMF_getState(&sm);
+        uint8_t uEvent;
+        /* a dead end would stall the walk, it is reported already */
+        if ((succ[cur - STATE_0] & ~STATE_BIT(cur)) == 0) {
+            *pNum = num = idx;
+            break;
+        }
+        do {
+            uEvent = EVENT_0 + rand() % EVENTSMAX;
+        } while (SMF_getAction(pTable, cur, uEvent) == NULL);
+        SMF_putEvent(&sm, &uEvent);
+        SMF_Run();
+    }
+    t1 = now();
+    return num ? (num / (t1 - t0)) : 0;
+}
+
+int main(int argc, char *argv[])
+{
+    const smfTable_t *pTable = &sunroofTable;
+    unsigned num = (argc > 1) ? (unsigned)atoi(argv[1]) : 1000000u;
+    uint16_t reach[STATESMAX];
+    uint16_t seen;
+    unsigned errors = 0, pairs = 0;
+    unsigned st, ev;
+
+    printf("%u states x %u events, start %s, stop %s\n",
+            STATESMAX, EVENTSMAX, stateName(SUNROOF_INIT_STATE),
+            stateName(SUNROOF_STOP_STATE));
+
+    seen = explore(pTable, SUNROOF_INIT_STATE, &errors);
+    closure(reach);
+
+    for (st = STATE_0; st < MAX_States; st++) {
+        const smfTimeout_t *pTmo = &pTable->timeout[st - STATE_0];
+        if (!(seen & STATE_BIT(st))) {
+            printf("ERROR  %s unreachable from %s\n",
+                    stateName(st), stateName(SUNROOF_INIT_STATE));
+            errors++;
+            continue;
+        }
+        for (ev = EVENT_0; ev < MAX_Events; ev++) {
+            if (SMF_getAction(pTable, st, ev) != NULL) {
+                pairs++;
+            } else {
+                printf("info   %s ignores %s\n", stateName(st), eventName(ev));
+            }
+        }
+        if (pTmo->ms && (SMF_getAction(pTable, st, pTmo->event) == NULL)) {
+            printf("ERROR  %s timeout event %s isn't handled\n",
+                    stateName(st), eventName(pTmo->event));
+            errors++;
+        }
+        if ((st != SUNROOF_STOP_STATE) &&
+            !(reach[st - STATE_0] & STATE_BIT(SUNROOF_STOP_STATE))) {
+            if ((succ[st - STATE_0] & ~STATE_BIT(st)) == 0) {
+                printf("ERROR  %s is a dead end\n", stateName(st));
+            } else {
+                printf("ERROR  %s is in a cycle without a path to %s\n",
+                        stateName(st), stateName(SUNROOF_STOP_STATE));
+            }
+            errors++;
+        }
+    }
+    printf("%u handled (state, event) pairs, %u errors\n", pairs, errors);
+
+    if (num) {
+        double rate = throughput(pTable, SUNROOF_INIT_STATE, &num);
+        printf("%.0f transitions/s over %u transitions\n", rate, num);
+    }
+    return errors ? 1 : 0;
+}
@@ -0,0 +1,55 @@
+/** 
+ * @file 	smfnames.h
+ * @author 	Mohit Rathod
+ * Created: 18 10 2026, 04:32:05 pm
+ * -----
+ * Last Modified: 18 10 2026, 04:32:05 pm
+ * Modified By  : Mohit Rathod
+ * -----
+ * MIT License
+ * https://opensource.org/licenses/MIT
+ * 
+ * @brief   Printable names of the sunroof states and events for the
+ *          host-side SMF tools.
+ */
+#ifndef tools_smf_names_h
+#define tools_smf_names_h
+#include <stddef.h>
+#include <utils/smf.h>
+#include "sunroof.h"
+
+static const char *const stName[STATESMAX] = {
+    [ST_OPEN - STATE_0]     = "ST_OPEN",
+    [ST_OPENING - STATE_0]  = "ST_OPENING",
+    [ST_CLOSE - STATE_0]    = "ST_CLOSE",
+    [ST_CLOSING - STATE_0]  = "ST_CLOSING",
+    [ST_STOPPED - STATE_0]  = "ST_STOPPED"
+};
+
+static const char *const evName[EVENTSMAX] = {
+    [EV_OPEN - EVENT_0]     = "EV_OPEN",
+    [EV_CLOSE - EVENT_0]    = "EV_CLOSE",
+    [EV_STOP - EVENT_0]     = "EV_STOP",
+    [EV_FSM_RST - EVENT_0]  = "EV_FSM_RST",
+    [EV_LIMIT - EVENT_0]    = "EV_LIMIT"
+};
+
+/**
+ * @brief   Name of a state, "?" when out of range or unnamed.
+ */
+static inline const char *stateName(unsigned uState)
+{
+    unsigned idx = uState - STATE_0;
+    return ((idx < STATESMAX) && (stName[idx] != NULL)) ? stName[idx] : "?";
+}
+
+/**
+ * @brief   Name of an event, "?" when out of range or unnamed.
+ */
+static inline const char *eventName(unsigned uEvent)
+{
+    unsigned idx = uEvent - EVENT_0;
+    return ((idx < EVENTSMAX) && (evName[idx] != NULL)) ? evName[idx] : "?";
+}
+
+#endif /* tools_smf_names_h */
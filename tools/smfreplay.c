@@ -0,0 +1,185 @@
+/** 
+ * @file 	smfreplay.c
+ * @author 	Mohit Rathod
+ * Created: 18 10 2026, 02:21:36 pm
+ * -----
+ * Last Modified: 19 10 2026, 12:51:46 am
+ * Modified By  : Mohit Rathod
+ * -----
+ * MIT License
+ * https://opensource.org/licenses/MIT
+ * 
+ * @brief   Host-side replay of an SMF transition trace.
+ *          Feeds the recorded events to the real SMF linked with the
+ *          sunroof transition table and checks that every transition
+ *          ends in the recorded state.
+ * 
+ *  Build (from the repository root):
+ *      gcc -std=gnu11 -I. -ImOS -Iutils -o smfreplay tools/smfreplay.c \
+ *          tools/hoststub.c sunroof.c utils/smf.c utils/queue.c \
+ *          utils/slip.c utils/icsserver.c utils/crc8.c
+ * 
+ *  Usage:
+ *      smfreplay [-r] [-v] <file>
+ *      <file>  UART capture holding a SLIP framed trace dump
+ *              (@ref SMF_traceDump), the last dump in it is used.
+ *      -r      <file> is a raw read-out of the ICS trace port
+ *              (@ref SMF_traceInit), the response block without the
+ *              return value and CRC: count byte, then the records.
+ *      -v      print the output of the actions while replaying.
+ * 
+ *  Returns 0 when the replay matches the trace, 1 otherwise.
+ */
+#include <stdio.h>
+#include <string.h>
+#include <mossch.h>
+#include <utils/smf.h>
+#include <utils/slip.h>
+#include "hoststub.h"
+#include "sunroof.h"
+#include "smfnames.h"
+
+#define TRACE_MAX               (2 + (255 * SMF_TRACE_REC_LEN))
+
+/**
+ * @brief   Extract the last SLIP frame starting with SMF_TRACE_MAGIC
+ *          from a UART capture. Text printed by the firmware around
+ *          the frame is skipped.
+ * @return  length of the trace (without the magic), -1 if none found.
+ */
+static int findDump(const uint8_t *cap, size_t capLen, uint8_t *trace)
+{
+    static uint8_t frame[TRACE_MAX + 1];
+    size_t len = 0;
+    size_t idx;
+    int esc = 0;
+    int ret = -1;
+    for (idx = 0; idx < capLen; idx++) {
+        uint8_t c = cap[idx];
+        if (c == SLIP_END) {
+            if ((len > 1) && (frame[0] == SMF_TRACE_MAGIC) &&
+                (len == (2 + (size_t)frame[1] * SMF_TRACE_REC_LEN))) {
+                memcpy(trace, &frame[1], len - 1);
+                ret = (int)(len - 1);
+            }
+            len = 0;
+            esc = 0;
+            continue;
+        }
+        if (esc) {
+            c = (c == SLIP_ESC_END) ? SLIP_END :
+                (c == SLIP_ESC_ESC) ? SLIP_ESC : c;
+            esc = 0;
+        }
+        else if (c == SLIP_ESC) {
+            esc = 1;
+            continue;
+        }
+        if (len < sizeof(frame)) {
+            frame[len++] = c;
+        }
+    }
+    return ret;
+}
+
+int main(int argc, char *argv[])
+{
+    static uint8_t cap[1 << 16];
+    static uint8_t trace[TRACE_MAX];
+    static smf_t sm[SMF_INSTANCES];
+    uint8_t live[SMF_INSTANCES] = {0};
+    const char *path = NULL;
+    int raw = 0;
+    int len;
+    int arg;
+    unsigned num, rec, fails = 0;
+    FILE *fp;
+    size_t capLen;
+
+    for (arg = 1; arg < argc; arg++) {
+        if (strcmp(argv[arg], "-r") == 0) {
+            raw = 1;
+        } else if (strcmp(argv[arg], "-v") == 0) {
+            hostVerbose = 1;
+        } else {
+            path = argv[arg];
+        }
+    }
+    if (path == NULL) {
+        fprintf(stderr, "usage: %s [-r] [-v] <file>\n", argv[0]);
+        return 2;
+    }
+    fp = fopen(path, "rb");
+    if (fp == NULL) {
+        perror(path);
+        return 2;
+    }
+    capLen = fread(cap, 1, sizeof(cap), fp);
+    fclose(fp);
+
+    if (raw) {
+        len = (int)((capLen < sizeof(trace)) ? capLen : sizeof(trace));
+        memcpy(trace, cap, len);
+    } else {
+        len = findDump(cap, capLen, trace);
+    }
+    if ((len < 1) || (len < (int)(1 + trace[0] * SMF_TRACE_REC_LEN))) {
+        fprintf(stderr, "%s: no complete SMF trace found\n", path);
+        return 2;
+    }
+
+    num = trace[0];
+    printf("%u transitions\n", num);
+    for (rec = 0; rec < num; rec++) {
+        const uint8_t *p = &trace[1 + rec * SMF_TRACE_REC_LEN];
+        unsigned tick = p[0] | (p[1] << 8);
+        unsigned inst = p[2] >> 4;
+        uint8_t uEvent = EVENT_0 + (p[2] & 0x0F);
+        state_t cur = (state_t)(STATE_0 + (p[3] >> 4));
+        state_t nxt = (state_t)(STATE_0 + (p[3] & 0x0F));
+        state_t got;
+
+        printf("%5u.%03us  #%u  %-10s --%-10s--> %-10s",
+                (tick * MOSS_TICK_MS) / 1000, (tick * MOSS_TICK_MS) % 1000,
+                inst, stateName(cur),
+                eventName(uEvent),
+                stateName(nxt));
+        if (inst >= SMF_INSTANCES) {
+            printf("  [skipped, unknown instance]\n");
+            fails++;
+            continue;
+        }
+        /* first record of an instance sets its starting state */
+        if (!live[inst]) {
+            if (SMF_init(&sm[inst], &sunroofTable, cur, NULL) != 0) {
+                printf("  [skipped, bad state]\n");
+                fails++;
+                continue;
+            }
+            live[inst] = 1;
+        }
+        if (SMF_getState(&sm[inst]) != cur) {
+            printf("  [GAP, replay was in %s]",
+                    stateName(SMF_getState(&sm[inst])));
+            fails++;
+            /* resync, the actions may have side effects we can't undo */
+            sm[inst].state = cur;
+        }
+        if (SMF_putEvent(&sm[inst], &uEvent) != 0) {
+            printf("  [REJECTED]\n");
+            fails++;
+            continue;
+        }
+        SMF_Run();
+        got = SMF_getState(&sm[inst]);
+        if (got == nxt) {
+            printf("  ok\n");
+        } else {
+            printf("  MISMATCH, replay went to %s\n",
+                    stateName(got));
+            fails++;
+        }
+    }
+    printf("%u mismatches\n", fails);
+    return fails ? 1 : 0;
+}
@@ -3,7 +3,7 @@
  * @author 	Mohit Rathod
  * Created: 22 09 2022, 09:29:41 pm
  * -----
- * Last Modified: 22 09 2022, 09:51:32 pm
+ * Last Modified: 19 10 2026, 12:04:11 am
  * Modified By  : Mohit Rathod
  * -----
  * MIT License
@@ -15,7 +15,7 @@
 #include <stddef.h>
 #include "crc8.h"
 
-static const uint8_t CRC8_SEED = 0xFF;
+static const uint8_t CRC8_SEED = CRC8_INIT;
 static const uint8_t CHECK_VAL = 0xDA;
 
 /**
@@ -78,4 +78,9 @@ int computeCRC(const uint8_t crc0, const uint8_t *pbuf, int len)
         ret = crc;
     }
     return ret;
+}
+
+uint8_t updateCRC(uint8_t crc, uint8_t data)
+{
+    return _CRCTable[data ^ crc];
 }
\ No newline at end of file
@@ -3,7 +3,7 @@
  * @author 	Mohit Rathod
  * Created: 22 09 2022, 09:08:15 pm
  * -----
- * Last Modified: 23 09 2022, 10:39:49 am
+ * Last Modified: 19 10 2026, 12:04:11 am
  * Modified By  : Mohit Rathod
  * -----
  * MIT License
@@ -19,6 +19,9 @@
 #define utils_crc8_h
 #include <stdint.h>
 
+/* Initial value of the CRC of a frame */
+#define CRC8_INIT               (0xFF)
+
 /**
  * @fn      int validate_crc8();
  * @brief   Test the validity of the CRC8 implementation.
@@ -49,4 +52,15 @@ int computeFCS(const uint8_t *pframe, int len);
  */
 int computeCRC(const uint8_t crc0, const uint8_t *pbuf, int len);
 
+/**
+ * @fn      uint8_t updateCRC(uint8_t crc, uint8_t data);
+ * @brief   Fold one more byte into a running crc8 value, for frames
+ *          checked as their bytes come in. Start from CRC8_INIT, the
+ *          value is 0 once the CRC byte of a good frame is folded in.
+ * @param   crc     crc of the bytes so far
+ * @param   data    next byte
+ * @return  crc value including data
+ */
+uint8_t updateCRC(uint8_t crc, uint8_t data);
+
 #endif /* utils_crc8_h */
\ No newline at end of file
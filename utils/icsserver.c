@@ -3,7 +3,7 @@
  * @author 	Mohit Rathod
  * Created: 10 10 2022, 09:56:18 pm
  * -----
- * Last Modified: 21 07 2024, 08:02:59 am
+ * Last Modified: 19 10 2026, 01:00:14 am
  * Modified By  : Mohit Rathod
  * -----
  * MIT License
@@ -24,9 +24,19 @@ typedef struct
 {
 	srvfn_t pService;
 	void *param;
+	void *back;					/* second param buffer, fragments land here */
 	uint8_t len;
 	uint8_t rsp;
-	volatile uint16_t run;
+	volatile uint8_t head;		/* requests queued by the parser */
+	volatile uint8_t tail;		/* requests run by ICS_run */
+	uint8_t *rspBuf;			/* response snapshots of rspLen bytes */
+	uint8_t rspLen;
+	uint8_t rspSwap;			/* 1 with two snapshots, 0 with one */
+	volatile uint8_t rspFront;	/* snapshot published to the host */
+#if MOS_USES(ICS_FLOWCTL)
+	uint8_t rxd;				/* request frames published by the ISR */
+	volatile uint8_t parsed;	/* and taken off the ring by the parser */
+#endif
 } services_t;
 
 typedef enum serverState
@@ -35,47 +45,213 @@ typedef enum serverState
 	HEADER_MODE,
 	LENGTH_MODE,
 	PORT_MODE,
+	ID_MODE,
 	DATA_MODE,
 	CRC_MODE,
+	SEQ_MODE,
+	TOTAL_MODE,
+	FRAG_DATA_MODE,
+	FRAG_CRC_MODE,
 	PKT_RSP_MODE,
-	SRVC_RSP_MODE
+	SRVC_RSP_MODE,
+	DONE_RSP_MODE,
+	REG_ADDR_MODE,
+	REG_MODE,
+	BATCH_MODE,
+	BATCH_CRC_MODE,
+	RAW_MODE,
+	INFO_MODE
 } Serverstate_t;
 
+/* Request flags */
+#define REQ_COPY				(0x01)	/* arguments to copy in the param buffer */
+#define REQ_ID					(0x02)	/* completion to report with the ID */
+#define REQ_SWAP				(0x04)	/* fragments complete in the back buffer */
+
+/* Max. records of a batch frame, one completion mask bit each */
+#define BATCH_RECS				(8)
+
+/* Queued request of a port */
+typedef struct
+{
+	uint8_t id;
+	uint8_t flags;
+	uint8_t args[MAX_PAYLOAD_LEN - 1];
+} request_t;
+
+/* Completed request, read back with ISMP_DONE_HEADER */
+typedef struct
+{
+	uint8_t port;
+	uint8_t id;
+	uint8_t rsp;
+} done_t;
+
+/* Fragmented transfer in progress */
+typedef struct
+{
+	uint8_t port;			/* port the buffer belongs to */
+	uint8_t seq;			/* next expected fragment */
+	uint8_t offset;			/* bytes of the buffer received so far */
+	uint8_t len;			/* data bytes in the current fragment */
+	uint8_t *buf;			/* buffer the fragments are written to */
+} fragment_t;
+
+/* Frame parser of a transport, a fragmented transfer belongs to the
+ * link it started on */
+typedef struct
+{
+	Serverstate_t state;
+	ISMPframe_t packet;
+	uint8_t fcs;			/* CRC of the frame bytes parsed so far */
+	uint8_t idx;			/* payload bytes parsed */
+	uint8_t req_id;			/* ID of a request frame */
+	ISMPresponse_t response;	/* of the last frame parsed */
+	fragment_t frag;
+} parser_t;
+
+/* Transports, each with its own parser */
+typedef enum
+{
+	LINK_I2C,				/* frames from the I2C ring, @see ICS_run */
+	LINK_PUT,				/* frames handed over by ICS_putFrame */
+	LINK_NUM
+} link_t;
+
+/* Descriptor header, @see ISMP_VERSION */
+static const uint8_t icsInfo[] = {
+	ISMP_PROTO_VERSION, MAX_PAYLOAD_LEN, ISMP_FRAG_DATA_LEN, ICS_BATCH_LEN, PORT_NUM_MAX
+};
+#define ICS_INFO_LEN			ISMP_INFO_LEN(PORT_NUM_MAX)
+
 static services_t i2csrvc[PORT_NUM_MAX];
+static request_t reqQ[PORT_NUM_MAX][ICS_REQ_DEPTH];
+/* Bit n set => port n has queued requests */
+static uint8_t pending;
+static parser_t parser[LINK_NUM];
+
+/* Completions, written by ICS_run and taken by the ISR or ICS_getDone,
+ * the ISR leaves the queue alone while done_busy is set */
+static done_t doneQ[ICS_DONE_DEPTH];
+static volatile uint8_t done_head;
+static volatile uint8_t done_tail;
+static volatile bool done_busy;
+static done_t done_rec;				/* the one being read over I2C */
+static uint8_t done_pos;
 
-static Serverstate_t state;
-static ISMPframe_t packet;
-static ISMPresponse_t response = UNKNOWN_RESP;
+/* Batch frame, owned by the parser while batch_len is 0 and by
+ * the dispatcher otherwise */
+static uint8_t batchBuf[ICS_BATCH_LEN];
+static uint8_t batchEnd[BATCH_RECS];	/* end of each record, as parsed */
+static volatile uint8_t batch_len;	/* ID + records, 0 when none pending */
+static uint8_t batch_pos;			/* next record to run */
+static uint8_t batch_rec;			/* records run so far */
+static uint8_t batch_mask;			/* records with a non-zero response */
 
-static int rsp_port = PORT_0;
+/* Register map */
+static const icsReg_t *reg_map;
+static uint8_t reg_num;
+static uint8_t reg_addr;			/* next register to read/write */
+static uint8_t reg_cnt;				/* bytes moved since the address */
+static const icsReg_t *reg_ent;		/* entry held in reg_latch */
+static uint8_t reg_latch[ICS_REG_LATCH];
+
+/* Frames written to the server are copied into this ring by the ISR
+ * as they arrive, each record a length byte followed by the frame,
+ * and parsed at the STOP or by ICS_run. */
+static uint8_t rxRing[ICS_RX_RING];
+static uint8_t rx_wr;				/* next free byte (ISR) */
+static uint8_t rx_start;			/* length byte of the frame being received */
+static volatile uint8_t rx_pub;		/* end of the last complete frame */
+static volatile uint8_t rx_tail;	/* start of the first unparsed frame */
+static bool rx_drop;				/* last frame didn't fit, reported BUSY */
+/* Set while the main loop parses or changes what the parser works on,
+ * the STOP interrupt then leaves its frame to ICS_run */
+static volatile bool parse_busy;
+static uint8_t rx_hdr;				/* header of the frame being received */
+static uint8_t rx_port;				/* its port if a request, else 0 */
+
+/* Frame counters, ICS_STAT_DROP is counted by the ISR, the rest by
+ * the parser */
+static uint16_t icsStats[ICS_STAT_NUM];
+
+static Serverstate_t bus;			/* transaction on the bus (ISR) */
+static volatile uint8_t rx_rsp = UNKNOWN_RESP;	/* of the last I2C frame */
+
+static ISMPport_t rsp_port = PORT_0;
+/* Response read in progress: bytes sent and snapshot latched (1 + index,
+ * 0 when none) for the whole read. */
+static uint8_t rsp_pos;
+static volatile uint8_t rsp_slot;
+static uint8_t rsp_crc;				/* CRC of the bytes sent so far */
+static uint8_t rsp_commit;			/* port whose service committed */
+static volatile uint8_t rsp_wr;		/* single snapshot port being written */
+static bool rsp_torn;				/* the read overlaps that, CRC spoiled */
+static uint8_t info_pos;			/* descriptor bytes sent */
 
 static void stateCallback(void);
 static void txCallback(volatile uint8_t *txdata);
 static void rxCallback(const uint8_t recvd);
-static void pushpacket(void);
+static void parseFrames(void);
+static void parseByte(parser_t *pP, uint8_t rxdata);
+static bool isFrameOpen(const parser_t *pP);
+static void dropTransfer(const parser_t *pP, uint8_t port);
+static uint8_t infoByte(uint8_t pos);
+static void countFrame(ISMPresponse_t rsp);
+#if MOS_USES(ICS_FLOWCTL)
+static bool isPortFull(uint8_t port);
+static void refuse(void);
+static bool isRequest(uint8_t hdr, uint8_t port);
+#endif
+static void pushpacket(parser_t *pP, uint8_t id, uint8_t flags);
 static bool isValidPort(ISMPport_t portNum);
+static uint8_t lowestBit(uint8_t mask);
+static bool isRspBusy(ISMPport_t portID);
+static bool claimRsp(ISMPport_t portID);
+static int setResponse(ISMPport_t portID, void *pbuf, uint8_t len, uint8_t swap);
+static void runService(ISMPport_t portID, const uint8_t *pArgs);
+static void runBatch(void);
+static void pushDone(uint8_t port, uint8_t id, uint8_t rsp);
+static const icsReg_t *regFind(uint8_t addr);
+static uint8_t regRead(void);
+static void regWrite(uint8_t data);
 
 int ICSserver_init()
 {
     ISMPport_t portID;
+    link_t link;
     for (portID = PORT_0; portID < (PORT_0 + PORT_NUM_MAX); portID++) {
         ICS_delService(portID);
     }
-    /* Enable the i2c dev in slave mode. */
-    i2cslave_init(stateCallback, txCallback, rxCallback, ICS_SERVER_ADDRESS);
+    for (link = LINK_I2C; link < LINK_NUM; link++) {
+        parser[link].state = HEADER_MODE;
+        parser[link].response = UNKNOWN_RESP;
+        parser[link].frag.port = 0;
+    }
     return 0;
 }
 
+int ICSi2c_init()
+{
+    bus = HEADER_MODE;
+    /* Enable the i2c dev in slave mode. */
+    return i2cslave_init(stateCallback, txCallback, rxCallback, ICS_SERVER_ADDRESS);
+}
+
 int ICS_addService(srvfn_t pService, const uint16_t len, void *pbuf, ISMPport_t portID)
 {
 	int ret = -1;
-	if ((portID >= PORT_0) && (portID < (PORT_0 + PORT_NUM_MAX))) {
+	if ((portID >= PORT_0) && (portID < (PORT_0 + PORT_NUM_MAX)) && (len <= UINT8_MAX)) {
 		if ((i2csrvc[portID - PORT_0].pService == NULL) && (pService != NULL)) {
 			i2csrvc[portID - PORT_0].pService = pService;
 			i2csrvc[portID - PORT_0].param = pbuf;
+			i2csrvc[portID - PORT_0].back = NULL;
 			i2csrvc[portID - PORT_0].len = len;
 			i2csrvc[portID - PORT_0].rsp = UNKNOWN_RESP;
-			i2csrvc[portID - PORT_0].run = 0;
+			i2csrvc[portID - PORT_0].head = 0;
+			i2csrvc[portID - PORT_0].tail = 0;
+			i2csrvc[portID - PORT_0].rspBuf = NULL;
+			i2csrvc[portID - PORT_0].rspLen = 0;
 			ret = 0;
 		}
 	}
@@ -86,11 +262,155 @@ int ICS_delService(ISMPport_t portID)
 {
 	int ret = -1;
 	if ((portID >= PORT_0) && (portID < (PORT_0 + PORT_NUM_MAX))) {
+		parse_busy = true;
 		i2csrvc[portID - PORT_0].pService = NULL;
 		i2csrvc[portID - PORT_0].param = NULL;
+		i2csrvc[portID - PORT_0].back = NULL;
 		i2csrvc[portID - PORT_0].len = 0;
 		i2csrvc[portID - PORT_0].rsp = 0;
-		i2csrvc[portID - PORT_0].run = 0;
+		i2csrvc[portID - PORT_0].head = 0;
+		i2csrvc[portID - PORT_0].tail = 0;
+		pending &= ~(1u << (portID - PORT_0));
+		i2csrvc[portID - PORT_0].rspBuf = NULL;
+		i2csrvc[portID - PORT_0].rspLen = 0;
+		parse_busy = false;
+		ret = 0;
+	}
+	return ret;
+}
+
+int ICS_setResponse(ISMPport_t portID, void *pbuf, uint8_t len)
+{
+	return setResponse(portID, pbuf, len, 1);
+}
+
+int ICS_setSingleResponse(ISMPport_t portID, void *pbuf, uint8_t len)
+{
+	return setResponse(portID, pbuf, len, 0);
+}
+
+int ICS_setParamBuffer(ISMPport_t portID, void *pbuf)
+{
+	int ret = -1;
+	if (isValidPort(portID) && (i2csrvc[portID - PORT_0].pService != NULL) &&
+		(i2csrvc[portID - PORT_0].param != NULL)) {
+		parse_busy = true;
+		i2csrvc[portID - PORT_0].back = pbuf;
+		/* a transfer under way was going to the other buffer */
+		dropTransfer(NULL, portID);
+		parse_busy = false;
+		ret = 0;
+	}
+	return ret;
+}
+
+void *ICS_rspBuffer(ISMPport_t portID)
+{
+	void *pbuf = NULL;
+	if (isValidPort(portID) && (i2csrvc[portID - PORT_0].rspLen != 0)) {
+		/* the snapshot the host isn't given, or the only one */
+		pbuf = i2csrvc[portID - PORT_0].rspBuf +
+			((i2csrvc[portID - PORT_0].rspFront ^ i2csrvc[portID - PORT_0].rspSwap) *
+			i2csrvc[portID - PORT_0].rspLen);
+	}
+	return pbuf;
+}
+
+int ICS_commitResponse(ISMPport_t portID)
+{
+	int ret = -1;
+	if (isValidPort(portID) && (i2csrvc[portID - PORT_0].rspLen != 0)) {
+		rsp_commit = portID;
+		ret = 0;
+	}
+	return ret;
+}
+
+int ICS_setRegMap(const icsReg_t *pMap, uint8_t num)
+{
+	int ret = -1;
+	if ((pMap != NULL) || (num == 0)) {
+		reg_num = 0;
+		reg_map = pMap;
+		reg_num = num;
+		ret = 0;
+	}
+	return ret;
+}
+
+ISMPresponse_t ICS_putFrame(const uint8_t *pFrame, uint8_t len)
+{
+	parser_t *pP = &parser[LINK_PUT];
+	pP->response = FRAME_SIZE_ERROR;
+	if ((pFrame != NULL) && (len != 0)) {
+		parse_busy = true;
+		pP->state = HEADER_MODE;
+		pP->fcs = CRC8_INIT;
+		do {
+			parseByte(pP, *pFrame++);
+		} while (--len && isFrameOpen(pP));
+		if (isFrameOpen(pP)) {
+			pP->response = FRAME_SIZE_ERROR;
+		}
+		countFrame(pP->response);
+		parse_busy = false;
+	}
+	return pP->response;
+}
+
+uint16_t ICS_getStat(icsStat_t stat)
+{
+	return (stat < ICS_STAT_NUM) ? icsStats[stat] : 0;
+}
+
+int ICS_getResponse(ISMPport_t portID, uint8_t *pDst, uint8_t maxLen)
+{
+	int ret = -1;
+	services_t *pSrvc;
+	if (isValidPort(portID) && (pDst != NULL)) {
+		pSrvc = &i2csrvc[portID - PORT_0];
+		/* return value, snapshot and CRC, the snapshot only changes
+		 * when a service runs so it's consistent here */
+		if ((pSrvc->rspLen + 2) <= maxLen) {
+			pDst[0] = pSrvc->rsp;
+			if (pSrvc->rspLen != 0) {
+				memcpy(&pDst[1], pSrvc->rspBuf + (pSrvc->rspFront * pSrvc->rspLen),
+					pSrvc->rspLen);
+			}
+			pDst[pSrvc->rspLen + 1] = computeFCS(pDst, pSrvc->rspLen + 1);
+			ret = pSrvc->rspLen + 2;
+		}
+	}
+	return ret;
+}
+
+int ICS_getInfo(uint8_t *pDst, uint8_t maxLen)
+{
+	int ret = -1;
+	uint8_t pos;
+	if ((pDst != NULL) && (maxLen > ICS_INFO_LEN)) {
+		for (pos = 0; pos < ICS_INFO_LEN; pos++) {
+			pDst[pos] = infoByte(pos);
+		}
+		pDst[ICS_INFO_LEN] = computeFCS(pDst, ICS_INFO_LEN);
+		ret = ICS_INFO_LEN + 1;
+	}
+	return ret;
+}
+
+int ICS_getDone(uint8_t *pDst)
+{
+	int ret = -1;
+	if (pDst != NULL) {
+		memset(pDst, 0, sizeof(done_t));
+		/* the check and the pop can't be split by the ISR taking the
+		 * same completion */
+		done_busy = true;
+		if (done_head != done_tail) {
+			memcpy(pDst, &doneQ[done_tail & (ICS_DONE_DEPTH - 1)], sizeof(done_t));
+			done_tail++;
+		}
+		done_busy = false;
 		ret = 0;
 	}
 	return ret;
@@ -99,24 +419,281 @@ int ICS_delService(ISMPport_t portID)
 void ICS_run()
 {
 	ISMPport_t portID;
-	for (portID = PORT_0; portID < (PORT_0 + PORT_NUM_MAX); portID++) {
-		if (i2csrvc[portID - PORT_0].pService) {
-			if (i2csrvc[portID - PORT_0].run > 0) {
-				i2csrvc[portID - PORT_0].rsp = i2csrvc[portID - PORT_0].pService(i2csrvc[portID - PORT_0].param);
-				/* Critical Section? */
-				i2csrvc[portID - PORT_0].run--;
+	services_t *pSrvc;
+	request_t *pReq;
+	void *pBuf;
+	uint8_t todo;
+	uint8_t again = 0;
+	uint8_t bit;
+	parse_busy = true;
+	parseFrames();
+	todo = pending;
+	pending = 0;
+	parse_busy = false;
+	/* a batch runs ahead of the queued requests */
+	if (batch_len != 0) {
+		runBatch();
+	}
+	/* only the ports with queued requests, idle costs a load */
+	while (todo) {
+		bit = todo & -todo;
+		todo &= ~bit;
+		portID = PORT_0 + lowestBit(bit);
+		pSrvc = &i2csrvc[portID - PORT_0];
+		pReq = &reqQ[portID - PORT_0][pSrvc->tail & (ICS_REQ_DEPTH - 1)];
+		/* one queued request per port per call, unless the snapshot
+		 * is being read or there is no room for the completion */
+		if (!((pReq->flags & REQ_ID) &&
+			  ((uint8_t)(done_head - done_tail) == ICS_DONE_DEPTH)) &&
+			claimRsp(portID)) {
+			if (pReq->flags & REQ_SWAP) {
+				/* the service gets the buffer the transfer completed in */
+				parse_busy = true;
+				pBuf = pSrvc->param;
+				pSrvc->param = pSrvc->back;
+				pSrvc->back = pBuf;
+				parse_busy = false;
+			}
+			runService(portID, (pReq->flags & REQ_COPY) ? pReq->args : NULL);
+			if (pReq->flags & REQ_ID) {
+				pushDone(portID, pReq->id, pSrvc->rsp);
+			}
+			pSrvc->tail++;
+		}
+		if (pSrvc->head != pSrvc->tail) {
+			again |= bit;
+		}
+	}
+	parse_busy = true;
+	pending |= again;
+	parse_busy = false;
+}
+
+/**
+ * @brief   Byte pos of the server descriptor. The port entries are
+ *          taken from the service registry, so they can't disagree
+ *          with what the parser accepts.
+ */
+static uint8_t infoByte(uint8_t pos)
+{
+	const services_t *pSrvc = i2csrvc;
+	uint8_t val;
+	if (pos < sizeof(icsInfo)) {
+		val = icsInfo[pos];
+	}
+	else {
+		/* no divide on the MSP430, at most PORT_NUM_MAX steps */
+		for (pos -= sizeof(icsInfo); pos >= 3; pos -= 3) {
+			pSrvc++;
+		}
+		if (pSrvc->pService == NULL) {
+			val = 0;
+		}
+		else if (pos == 0) {
+			val = pSrvc->len;
+		}
+		else if (pos == 1) {
+			val = pSrvc->rspLen;
+		}
+		else {
+			val = ISMP_PORT_ACTIVE;
+			if (pSrvc->len > (MAX_PAYLOAD_LEN - 1)) {
+				val |= ISMP_PORT_FRAG;
+			}
+			if (pSrvc->back != NULL) {
+				val |= ISMP_PORT_BUF2;
+			}
+		}
+	}
+	return val;
+}
+
+/**
+ * @brief   Index of the lowest bit set in a non-zero mask.
+ */
+static uint8_t lowestBit(uint8_t mask)
+{
+	static const uint8_t nibble[16] = {
+		0, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0
+	};
+	return (mask & 0x0F) ? nibble[mask & 0x0F] : (4 + nibble[mask >> 4]);
+}
+
+/**
+ * @brief   The host is still reading the response snapshot the
+ *          service of the port would write.
+ */
+static bool isRspBusy(ISMPport_t portID)
+{
+	return (i2csrvc[portID - PORT_0].rspLen != 0) && (rsp_port == portID) &&
+		(rsp_slot == ((i2csrvc[portID - PORT_0].rspFront ^
+						i2csrvc[portID - PORT_0].rspSwap) + 1));
+}
+
+/**
+ * @brief   Claim the response snapshot a service is about to write.
+ *          A single snapshot is marked as written before the read is
+ *          checked, so a read that starts after the check spoils its
+ *          CRC rather than passing torn.
+ * @return  false if the host is reading it, the service must wait.
+ */
+static bool claimRsp(ISMPport_t portID)
+{
+	bool ret = true;
+	if ((i2csrvc[portID - PORT_0].rspSwap == 0) &&
+		(i2csrvc[portID - PORT_0].rspLen != 0)) {
+		rsp_wr = portID;
+	}
+	if (isRspBusy(portID)) {
+		rsp_wr = 0;
+		ret = false;
+	}
+	return ret;
+}
+
+/**
+ * @brief   Give the service of a port a response of one (swap 0) or
+ *          two (swap 1) snapshots.
+ */
+static int setResponse(ISMPport_t portID, void *pbuf, uint8_t len, uint8_t swap)
+{
+	int ret = -1;
+	if (isValidPort(portID) && (i2csrvc[portID - PORT_0].pService != NULL) &&
+		((pbuf != NULL) || (len == 0))) {
+		i2csrvc[portID - PORT_0].rspLen = 0;
+		i2csrvc[portID - PORT_0].rspBuf = pbuf;
+		i2csrvc[portID - PORT_0].rspSwap = swap;
+		i2csrvc[portID - PORT_0].rspFront = 0;
+		i2csrvc[portID - PORT_0].rspLen = len;
+		ret = 0;
+	}
+	return ret;
+}
+
+/**
+ * @brief   Run the service of a port, pArgs (if any) are copied into
+ *          its parameter buffer first. The snapshot has been claimed
+ *          (@see claimRsp), a single one is written in place.
+ */
+static void runService(ISMPport_t portID, const uint8_t *pArgs)
+{
+	services_t *pSrvc = &i2csrvc[portID - PORT_0];
+	if ((pArgs != NULL) && (pSrvc->param != NULL)) {
+		memcpy(pSrvc->param, pArgs, pSrvc->len);
+	}
+	if (pSrvc->rspSwap) {
+		/* the service starts from the published snapshot, so a
+		 * partial update stays coherent */
+		memcpy(pSrvc->rspBuf + ((pSrvc->rspFront ^ 1) * pSrvc->rspLen),
+			pSrvc->rspBuf + (pSrvc->rspFront * pSrvc->rspLen), pSrvc->rspLen);
+	}
+	rsp_commit = 0;
+	pSrvc->rsp = pSrvc->pService(pSrvc->param);
+	rsp_wr = 0;
+	/* publish the snapshot once the service commits it */
+	if (rsp_commit == portID) {
+		pSrvc->rspFront ^= pSrvc->rspSwap;
+		rsp_commit = 0;
+	}
+}
+
+/**
+ * @brief   Run the records of the pending batch in order. A record
+ *          whose response snapshot is being read is resumed from on
+ *          a later call.
+ */
+static void runBatch(void)
+{
+	ISMPport_t portID;
+	if ((uint8_t)(done_head - done_tail) == ICS_DONE_DEPTH) {
+		return;
+	}
+	while (batch_pos < batch_len) {
+		portID = batchBuf[batch_pos];
+		if (isValidPort(portID) && !claimRsp(portID)) {
+			return;
+		}
+		/* the record is walked by the lengths the parser checked, a
+		 * service removed or replaced since then doesn't run */
+		if (isValidPort(portID) && (i2csrvc[portID - PORT_0].pService != NULL) &&
+			((batch_pos + 1 + i2csrvc[portID - PORT_0].len) == batchEnd[batch_rec])) {
+			runService(portID, &batchBuf[batch_pos + 1]);
+			if (i2csrvc[portID - PORT_0].rsp != 0) {
+				batch_mask |= (1u << batch_rec);
 			}
 		}
+		else {
+			rsp_wr = 0;
+			batch_mask |= (1u << batch_rec);
+		}
+		batch_pos = batchEnd[batch_rec++];
 	}
+	pushDone(ISMP_BATCH_HEADER, batchBuf[0], batch_mask);
+	/* hand the buffer back to the parser */
+	batch_len = 0;
+}
+
+static void pushDone(uint8_t port, uint8_t id, uint8_t rsp)
+{
+	doneQ[done_head & (ICS_DONE_DEPTH - 1)].port = port;
+	doneQ[done_head & (ICS_DONE_DEPTH - 1)].id = id;
+	doneQ[done_head & (ICS_DONE_DEPTH - 1)].rsp = rsp;
+	done_head++;
 }
 
 static void stateCallback(void)
 {
-	switch (state)
+	switch (bus)
 	{
+	case(RAW_MODE):
+		/* end of a frame, hand it over to ICS_run */
+		rxRing[rx_start & (ICS_RX_RING - 1)] = rx_wr - rx_start - 1;
+#if MOS_USES(ICS_FLOWCTL)
+		if (rx_port != 0) {
+			i2csrvc[rx_port - PORT_0].rxd++;
+		}
+#endif
+		rx_pub = rx_wr;
+		bus = HEADER_MODE;
+#if !MOS_USES(ICS_DEFER)
+		/* parsed right away, so the status read that follows has the
+		 * response, unless the main loop is parsing */
+		if (!parse_busy) {
+			parseFrames();
+		}
+#endif
+		break;
 	case(BAD_FRAME):
 		/* reset state */
-		state = HEADER_MODE;
+		bus = HEADER_MODE;
+		break;
+	case(SRVC_RSP_MODE):
+		/* the host ended a response read early */
+		if (rsp_pos != 0) {
+			bus = HEADER_MODE;
+			rsp_slot = 0;
+		}
+		break;
+	case(DONE_RSP_MODE):
+		if (done_pos != 0) {
+			bus = HEADER_MODE;
+		}
+		break;
+	case(INFO_MODE):
+		if (info_pos != 0) {
+			bus = HEADER_MODE;
+		}
+		break;
+	case(REG_ADDR_MODE):
+		bus = HEADER_MODE;
+		break;
+	case(REG_MODE):
+		/* a repeated START between the address and a read keeps
+		 * the address, a STOP or any condition after data ends
+		 * the access */
+		if ((reg_cnt != 0) || i2cslave_isStop()) {
+			bus = HEADER_MODE;
+		}
 		break;
 	
 	default:
@@ -127,101 +704,543 @@ static void stateCallback(void)
 
 static void txCallback(volatile uint8_t *txdata)
 {
-	switch(state)
+	uint8_t data;
+	switch(bus)
 	{
 		case(SRVC_RSP_MODE):
-			state = HEADER_MODE;
-			*txdata = i2csrvc[rsp_port - PORT_0].rsp;
+			/* service return value, the published snapshot, then the
+			 * CRC of both, folded in byte by byte as they are sent */
+			if (rsp_pos == 0) {
+				data = i2csrvc[rsp_port - PORT_0].rsp;
+				rsp_slot = i2csrvc[rsp_port - PORT_0].rspFront + 1;
+				rsp_crc = CRC8_INIT;
+				rsp_torn = (rsp_wr == rsp_port);
+			}
+			else if (rsp_pos <= i2csrvc[rsp_port - PORT_0].rspLen) {
+				data = i2csrvc[rsp_port - PORT_0].rspBuf[((rsp_slot - 1) *
+							i2csrvc[rsp_port - PORT_0].rspLen) + rsp_pos - 1];
+			}
+			else {
+				data = rsp_torn ? (uint8_t)~rsp_crc : rsp_crc;
+				bus = HEADER_MODE;
+			}
+			rsp_crc = updateCRC(rsp_crc, data);
+			*txdata = data;
+			/* the snapshot is released with its last byte */
+			if (rsp_pos++ == i2csrvc[rsp_port - PORT_0].rspLen) {
+				rsp_slot = 0;
+			}
 			break;
 		case(PKT_RSP_MODE):
-			state = HEADER_MODE;
-			*txdata = response;
-			response = UNKNOWN_RESP;
+			bus = HEADER_MODE;
+			/* response of the last frame once it has been parsed */
+			if (rx_drop) {
+				*txdata = FRAME_OK_SRVC_BUSY;
+				rx_drop = false;
+			}
+			else if (rx_tail != rx_pub) {
+				*txdata = ISMP_ONGOING;
+			}
+			else {
+				*txdata = rx_rsp;
+				rx_rsp = UNKNOWN_RESP;
+			}
+			break;
+		case(DONE_RSP_MODE):
+			/* port, ID and response of the oldest completion, all 0
+			 * when there is none or ICS_getDone is taking one. It
+			 * leaves the queue with the first byte, so it goes out
+			 * over one link only */
+			if (done_pos == 0) {
+				memset(&done_rec, 0, sizeof(done_t));
+				if (!done_busy && (done_head != done_tail)) {
+					done_rec = doneQ[done_tail & (ICS_DONE_DEPTH - 1)];
+					done_tail++;
+				}
+			}
+			*txdata = ((uint8_t *)&done_rec)[done_pos];
+			if (++done_pos == sizeof(done_t)) {
+				bus = HEADER_MODE;
+			}
+			break;
+		case(REG_MODE):
+			*txdata = regRead();
+			reg_cnt++;
+			break;
+		case(INFO_MODE):
+			/* descriptor, then its CRC */
+			if (info_pos < ICS_INFO_LEN) {
+				data = infoByte(info_pos++);
+				rsp_crc = updateCRC(rsp_crc, data);
+			}
+			else {
+				data = rsp_crc;
+				bus = HEADER_MODE;
+			}
+			*txdata = data;
 			break;
 		default:
-			/* no operation */
+			/* nothing to send, don't leave the bus stretched */
+			*txdata = UNKNOWN_RESP;
 			break;
 	}
 }
 
 static void rxCallback(const uint8_t recvd)
 {
-	static int idx = 0;
-	uint8_t rxdata = recvd;
-	switch(state)
+	switch(bus)
 	{
 		case(HEADER_MODE):
 			/* If a portID is sent to enquire its service response. */
-			if (isValidPort(rxdata)) {
-				state = SRVC_RSP_MODE;
-				rsp_port = rxdata;
+			if (isValidPort(recvd)) {
+				bus = SRVC_RSP_MODE;
+				rsp_port = (ISMPport_t)recvd;
+				rsp_pos = 0;
 			}
 			/* or if current server state is requested */
-			else if (rxdata == ISMP_RSP_HEADER) {
-				state = PKT_RSP_MODE;
+			else if (recvd == ISMP_RSP_HEADER) {
+				bus = PKT_RSP_MODE;
+			}
+			/* or the result of a request sent with an ID */
+			else if (recvd == ISMP_DONE_HEADER) {
+				bus = DONE_RSP_MODE;
+				done_pos = 0;
+			}
+			/* or the server descriptor */
+			else if (recvd == ISMP_VERSION) {
+				bus = INFO_MODE;
+				info_pos = 0;
+				rsp_crc = CRC8_INIT;
+			}
+			/* or a register address follows */
+			else if ((recvd == ISMP_REG_HEADER) && (reg_num != 0)) {
+				bus = REG_ADDR_MODE;
+			}
+			/* anything else is a frame for ICS_run, room is left for
+			 * its length and the header */
+			else if ((uint8_t)(rx_wr - rx_tail) <= (ICS_RX_RING - 2)) {
+				bus = RAW_MODE;
+				rx_drop = false;
+				rx_start = rx_wr;
+				rx_hdr = recvd;
+				rx_port = 0;
+				rxRing[(rx_wr + 1) & (ICS_RX_RING - 1)] = recvd;
+				rx_wr += 2;
+#if MOS_USES(ICS_FLOWCTL)
+				/* no room left for a request frame, or a batch is
+				 * yet to run */
+				if (((uint8_t)(rx_wr - rx_tail) > (ICS_RX_RING - MAX_PACKET_LEN)) ||
+					((recvd == ISMP_BATCH_HEADER) && (batch_len != 0))) {
+					refuse();
+				}
+#endif
+			}
+			else {
+				bus = BAD_FRAME;
+				rx_drop = true;
+				icsStats[ICS_STAT_DROP]++;
+#if MOS_USES(ICS_FLOWCTL)
+				i2cslave_nack();
+#endif
+			}
+			break;
+		case(RAW_MODE):
+			if ((uint8_t)(rx_wr - rx_tail) < ICS_RX_RING) {
+				rxRing[rx_wr++ & (ICS_RX_RING - 1)] = recvd;
+#if MOS_USES(ICS_FLOWCTL)
+				/* the port of a request, refused if its queue is full */
+				if (((uint8_t)(rx_wr - rx_start) == 4) &&
+					isRequest(rx_hdr, recvd)) {
+					if (isPortFull(recvd)) {
+						refuse();
+					}
+					else {
+						rx_port = recvd;
+					}
+				}
+#endif
+			}
+			else {
+				/* no room left, drop the frame */
+				bus = BAD_FRAME;
+				rx_wr = rx_start;
+				rx_drop = true;
+				icsStats[ICS_STAT_DROP]++;
+			}
+			break;
+		case(REG_ADDR_MODE):
+			reg_addr = recvd;
+			reg_cnt = 0;
+			reg_ent = NULL;
+			bus = REG_MODE;
+			break;
+		case(REG_MODE):
+			regWrite(recvd);
+			reg_cnt++;
+			break;
+		case(BAD_FRAME):
+		default:
+			/* no_operation */
+		break;
+	}
+}
+
+#if MOS_USES(ICS_FLOWCTL)
+/**
+ * @brief   Drop the frame being received and NACK its next byte, so the
+ *          master backs off without sending the rest of it.
+ */
+static void refuse(void)
+{
+	i2cslave_nack();
+	bus = BAD_FRAME;
+	rx_wr = rx_start;
+	rx_drop = true;
+	icsStats[ICS_STAT_DROP]++;
+}
+
+/**
+ * @brief   A frame to queue on a service port.
+ */
+static bool isRequest(uint8_t hdr, uint8_t port)
+{
+	return ((hdr == ISMP_SVC_HEADER) || (hdr == ISMP_REQ_HEADER)) &&
+			isValidPort(port);
+}
+
+/**
+ * @brief   The requests queued on a port and those still on the ring
+ *          fill its queue.
+ */
+static bool isPortFull(uint8_t port)
+{
+	services_t *pSrvc = &i2csrvc[port - PORT_0];
+	return ((uint8_t)(pSrvc->head - pSrvc->tail) +
+			(uint8_t)(pSrvc->rxd - pSrvc->parsed)) >= ICS_REQ_DEPTH;
+}
+#endif
+
+/**
+ * @brief   Parse the frames handed over by the ISR, from its STOP
+ *          (@see MOS_CONFIG_ICS_DEFER) or ICS_run. The response of a
+ *          frame is set before the frame is released, until then the
+ *          host reads ISMP_ONGOING.
+ */
+static void parseFrames(void)
+{
+	parser_t *pP = &parser[LINK_I2C];
+	uint8_t pos;
+	uint8_t len;
+#if MOS_USES(ICS_FLOWCTL)
+	uint8_t port;
+#endif
+	while (rx_tail != rx_pub) {
+		pos = rx_tail;
+		len = rxRing[pos++ & (ICS_RX_RING - 1)];
+#if MOS_USES(ICS_FLOWCTL)
+		port = rxRing[(pos + 2) & (ICS_RX_RING - 1)];
+		if ((len < 3) || !isRequest(rxRing[pos & (ICS_RX_RING - 1)], port)) {
+			port = 0;
+		}
+#endif
+		pP->state = HEADER_MODE;
+		pP->fcs = CRC8_INIT;
+		/* bytes past the end of the frame are ignored */
+		do {
+			parseByte(pP, rxRing[pos++ & (ICS_RX_RING - 1)]);
+		} while (--len && isFrameOpen(pP));
+		if (isFrameOpen(pP)) {
+			/* the host ended the write short of the frame */
+			pP->response = FRAME_SIZE_ERROR;
+		}
+		rx_rsp = pP->response;
+		countFrame(pP->response);
+#if MOS_USES(ICS_FLOWCTL)
+		/* as counted by the ISR, once queued so it never sees the
+		 * request in neither count */
+		if (port != 0) {
+			i2csrvc[port - PORT_0].parsed++;
+		}
+#endif
+		rx_tail += 1 + rxRing[rx_tail & (ICS_RX_RING - 1)];
+	}
+}
+
+/**
+ * @brief   Count the response to a parsed frame.
+ */
+static void countFrame(ISMPresponse_t rsp)
+{
+	icsStat_t stat;
+	switch (rsp)
+	{
+		case FRAME_OK:				stat = ICS_STAT_OK;		break;
+		case FRAME_OK_SRVC_BUSY:	stat = ICS_STAT_BUSY;	break;
+		case HEADER_ERROR:			stat = ICS_STAT_HEADER;	break;
+		case CHECKSUM_ERROR:		stat = ICS_STAT_CRC;	break;
+		case FRAME_SIZE_ERROR:		stat = ICS_STAT_SIZE;	break;
+		case INVALID_PARAMS:		stat = ICS_STAT_PARAMS;	break;
+		case INVALID_SRVC:			stat = ICS_STAT_SRVC;	break;
+		case INVALID_PORT:			stat = ICS_STAT_PORT;	break;
+		case SEQUENCE_ERROR:		stat = ICS_STAT_SEQ;	break;
+		default:					stat = ICS_STAT_NUM;	break;
+	}
+	if (stat < ICS_STAT_NUM) {
+		icsStats[stat]++;
+	}
+}
+
+/**
+ * @brief   The parser is part way through a frame.
+ */
+static bool isFrameOpen(const parser_t *pP)
+{
+	return (pP->state != HEADER_MODE) && (pP->state != BAD_FRAME);
+}
+
+/**
+ * @brief   Abandon the transfers to port of the links other than pP's
+ *          (of all links when NULL), their next fragment gets
+ *          SEQUENCE_ERROR.
+ */
+static void dropTransfer(const parser_t *pP, uint8_t port)
+{
+	link_t link;
+	for (link = LINK_I2C; link < LINK_NUM; link++) {
+		if ((&parser[link] != pP) && (parser[link].frag.port == port)) {
+			parser[link].frag.port = 0;
+		}
+	}
+}
+
+static void parseByte(parser_t *pP, uint8_t rxdata)
+{
+	/* every byte of the frame, its CRC included, is folded in as it
+	 * is parsed, so the check at the end is a compare with 0 */
+	pP->fcs = updateCRC(pP->fcs, rxdata);
+	switch(pP->state)
+	{
+		case(HEADER_MODE):
+			/* a batch is refused up front while the last one is pending */
+			if (rxdata == ISMP_BATCH_HEADER) {
+				pP->state = LENGTH_MODE;
+				pP->packet.Header = rxdata;
+				pP->response = ISMP_ONGOING;
+				if (batch_len != 0) {
+					pP->state = BAD_FRAME;
+					pP->response = FRAME_OK_SRVC_BUSY;
+				}
 			}
 			/* if a ISMP service header is sent to indicate an ISMP frame */
-			else if (rxdata == ISMP_SVC_HEADER) {
-				state = LENGTH_MODE;
-				packet.Header = ISMP_SVC_HEADER;
-				response = ISMP_ONGOING;
+			else if ((rxdata == ISMP_SVC_HEADER) || (rxdata == ISMP_FRAG_HEADER) ||
+					 (rxdata == ISMP_REQ_HEADER)) {
+				pP->state = LENGTH_MODE;
+				pP->packet.Header = rxdata;
+				pP->response = ISMP_ONGOING;
 			}
 			else {
-				state = BAD_FRAME;
-				response = HEADER_ERROR;
+				pP->state = BAD_FRAME;
+				pP->response = HEADER_ERROR;
 			}
 			break;
 		case(LENGTH_MODE):
-			if ((rxdata > 0) && (rxdata <= MAX_PAYLOAD_LEN)) {
-				state = PORT_MODE;
-				response = ISMP_ONGOING;
-				packet.Len = rxdata;
-				idx = rxdata;
+			/* an ID and at least one record */
+			if (pP->packet.Header == ISMP_BATCH_HEADER) {
+				pP->state = BATCH_MODE;
+				pP->response = ISMP_ONGOING;
+				pP->packet.Len = rxdata;
+				pP->idx = 0;
+				batch_rec = 0;
+				if ((rxdata < 2) || (rxdata > ICS_BATCH_LEN)) {
+					pP->state = BAD_FRAME;
+					pP->response = FRAME_SIZE_ERROR;
+				}
+			}
+			/* a fragment holds at least one data byte */
+			else if ((pP->packet.Header == ISMP_FRAG_HEADER) ?
+				((rxdata > 3) && (rxdata <= (ISMP_FRAG_DATA_LEN + 3))) :
+				((rxdata > (pP->packet.Header == ISMP_REQ_HEADER)) &&
+				 (rxdata <= (MAX_PAYLOAD_LEN + (pP->packet.Header == ISMP_REQ_HEADER))))) {
+				pP->state = PORT_MODE;
+				pP->response = ISMP_ONGOING;
+				pP->packet.Len = rxdata;
+				pP->idx = 0;
 			}
 			else {
-				state = BAD_FRAME;
-				response = FRAME_SIZE_ERROR;
+				pP->state = BAD_FRAME;
+				pP->response = FRAME_SIZE_ERROR;
 			}
 			break;
 		case(PORT_MODE):
 			if (isValidPort(rxdata)) {
-				state = DATA_MODE;
-				packet.Port = rxdata;
+				pP->state = DATA_MODE;
+				pP->packet.Port = rxdata;
 				/* if no service registered at this portID */
-				if (i2csrvc[packet.Port - PORT_0].pService == NULL) {
-					state = BAD_FRAME;
-					response = INVALID_SRVC;
+				if (i2csrvc[pP->packet.Port - PORT_0].pService == NULL) {
+					pP->state = BAD_FRAME;
+					pP->response = INVALID_SRVC;
+				}
+				/* fragments are checked against the total length */
+				else if (pP->packet.Header == ISMP_FRAG_HEADER) {
+					pP->state = SEQ_MODE;
 				}
 				/* if not enough parameters for the service at this portID */
-				else if (i2csrvc[packet.Port - PORT_0].len != (packet.Len - 1)) {
-					state = BAD_FRAME;
-					response = INVALID_PARAMS;
+				else if (i2csrvc[pP->packet.Port - PORT_0].len !=
+						 (pP->packet.Len - 1 - (pP->packet.Header == ISMP_REQ_HEADER))) {
+					pP->state = BAD_FRAME;
+					pP->response = INVALID_PARAMS;
+				}
+				else if (pP->packet.Header == ISMP_REQ_HEADER) {
+					pP->state = ID_MODE;
 				}
 			}
 			else {
-				state = BAD_FRAME;
-				response = INVALID_PORT;
+				pP->state = BAD_FRAME;
+				pP->response = INVALID_PORT;
 			}
 			break;
+		case(ID_MODE):
+			pP->req_id = rxdata;
+			pP->state = DATA_MODE;
+			break;
 		case(DATA_MODE):
-			if (idx > 1) {
-				packet.Data[packet.Len - idx] = rxdata;
-				idx--;
+			if (pP->idx < i2csrvc[pP->packet.Port - PORT_0].len) {
+				pP->packet.Data[pP->idx++] = rxdata;
 				break;
 			}
-			state = CRC_MODE;
+			pP->state = CRC_MODE;
+			/* fall through */
 		case(CRC_MODE):
 			/* Last byte in the packet is the checksum */
-			packet.buf[packet.Len + 2] = rxdata;
-			if (computeFCS(packet.buf, (packet.Len+3))) {
+			if (pP->fcs != 0) {
 				/* Bad packet let the host know and discard the frame. */
-				state = BAD_FRAME;
-				response = CHECKSUM_ERROR;
+				pP->state = BAD_FRAME;
+				pP->response = CHECKSUM_ERROR;
 			}
 			else {
-				state = HEADER_MODE;
-				response = FRAME_OK;
-				pushpacket();
+				pP->state = HEADER_MODE;
+				pP->response = FRAME_OK;
+				if (pP->packet.Header == ISMP_REQ_HEADER) {
+					pushpacket(pP, pP->req_id, REQ_COPY | REQ_ID);
+				}
+				else {
+					pushpacket(pP, 0, REQ_COPY);
+				}
+			}
+			break;
+		case(SEQ_MODE):
+			pP->state = TOTAL_MODE;
+			/* Fragment 0 (re)starts a transfer, unless the service
+			 * is yet to run on the previous buffer. */
+			if (rxdata == 0) {
+				if (i2csrvc[pP->packet.Port - PORT_0].head != i2csrvc[pP->packet.Port - PORT_0].tail) {
+					pP->state = BAD_FRAME;
+					pP->response = FRAME_OK_SRVC_BUSY;
+				}
+				else {
+					/* the buffer is written from this link only */
+					dropTransfer(pP, pP->packet.Port);
+					pP->frag.port = pP->packet.Port;
+					pP->frag.seq = 0;
+					pP->frag.offset = 0;
+					/* the back buffer when there is one, so the service
+					 * keeps its last arguments until the swap */
+					pP->frag.buf = (i2csrvc[pP->packet.Port - PORT_0].back != NULL) ?
+						i2csrvc[pP->packet.Port - PORT_0].back :
+						i2csrvc[pP->packet.Port - PORT_0].param;
+				}
+			}
+			else if ((pP->packet.Port != pP->frag.port) || (rxdata != pP->frag.seq)) {
+				pP->state = BAD_FRAME;
+				pP->response = SEQUENCE_ERROR;
+			}
+			break;
+		case(TOTAL_MODE):
+			pP->frag.len = pP->packet.Len - 3;
+			pP->idx = 0;
+			pP->state = FRAG_DATA_MODE;
+			/* The fragment must fit the service buffer */
+			if ((pP->frag.buf == NULL) ||
+				(rxdata != i2csrvc[pP->packet.Port - PORT_0].len) ||
+				((pP->frag.offset + pP->frag.len) > rxdata)) {
+				pP->state = BAD_FRAME;
+				pP->response = INVALID_PARAMS;
+			}
+			break;
+		case(FRAG_DATA_MODE):
+			/* Stream straight into the buffer, the offset only moves
+			 * on once the fragment CRC checks out. */
+			pP->frag.buf[pP->frag.offset + pP->idx] = rxdata;
+			if (++pP->idx == pP->frag.len) {
+				pP->state = FRAG_CRC_MODE;
+			}
+			break;
+		case(FRAG_CRC_MODE):
+			if (pP->fcs != 0) {
+				pP->state = BAD_FRAME;
+				pP->response = CHECKSUM_ERROR;
+			}
+			else {
+				pP->state = HEADER_MODE;
+				pP->response = FRAME_OK;
+				pP->frag.offset += pP->frag.len;
+				pP->frag.seq++;
+				/* Whole buffer received, run the service on it */
+				if (pP->frag.offset == i2csrvc[pP->packet.Port - PORT_0].len) {
+					pushpacket(pP, 0, (i2csrvc[pP->packet.Port - PORT_0].back != NULL) ?
+						REQ_SWAP : 0);
+				}
+			}
+			break;
+		case(BATCH_MODE):
+			batchBuf[pP->idx] = rxdata;
+			/* ID first, then records of a port and its arguments */
+			if (pP->idx == 0) {
+				batch_pos = 0;
+			}
+			else if (batch_pos != 0) {
+				batch_pos--;
+			}
+			else if (!isValidPort(rxdata)) {
+				pP->state = BAD_FRAME;
+				pP->response = INVALID_PORT;
+			}
+			else if (i2csrvc[rxdata - PORT_0].pService == NULL) {
+				pP->state = BAD_FRAME;
+				pP->response = INVALID_SRVC;
+			}
+			else if ((i2csrvc[rxdata - PORT_0].len > (MAX_PAYLOAD_LEN - 1)) ||
+					 (batch_rec == BATCH_RECS)) {
+				pP->state = BAD_FRAME;
+				pP->response = INVALID_PARAMS;
+			}
+			else {
+				/* arguments still to come for this record */
+				batch_pos = i2csrvc[rxdata - PORT_0].len;
+				batchEnd[batch_rec++] = pP->idx + 1 + batch_pos;
+			}
+			if ((++pP->idx == pP->packet.Len) && (pP->state == BATCH_MODE)) {
+				pP->state = BATCH_CRC_MODE;
+			}
+			break;
+		case(BATCH_CRC_MODE):
+			if (pP->fcs != 0) {
+				pP->state = BAD_FRAME;
+				pP->response = CHECKSUM_ERROR;
+			}
+			/* the last record is short of arguments */
+			else if ((batch_pos != 0) || (batch_rec == 0)) {
+				pP->state = BAD_FRAME;
+				pP->response = INVALID_PARAMS;
+			}
+			else {
+				pP->state = HEADER_MODE;
+				pP->response = FRAME_OK;
+				batch_pos = 1;
+				batch_rec = 0;
+				batch_mask = 0;
+				/* hand the batch over to ICS_run */
+				batch_len = pP->packet.Len;
 			}
 			break;
 		case(BAD_FRAME):
@@ -230,18 +1249,25 @@ static void rxCallback(const uint8_t recvd)
 		break;
 	}
 }
-static void pushpacket(void)
+static void pushpacket(parser_t *pP, uint8_t id, uint8_t flags)
 {
-	if (i2csrvc[packet.Port - PORT_0].run != 0) {
-		response = FRAME_OK_SRVC_BUSY;
+	services_t *pSrvc = &i2csrvc[pP->packet.Port - PORT_0];
+	request_t *pReq;
+	if ((uint8_t)(pSrvc->head - pSrvc->tail) == ICS_REQ_DEPTH) {
+		pP->response = FRAME_OK_SRVC_BUSY;
 	}
 	else {
-		i2csrvc[packet.Port - PORT_0].run++;
-		/* check for null buffers in param */
-		if (i2csrvc[packet.Port - PORT_0].param) {
-			memcpy(i2csrvc[packet.Port - PORT_0].param, packet.Data, i2csrvc[packet.Port - PORT_0].len);
+		/* The arguments are copied into param by ICS_run, right
+		 * before the service runs. */
+		pReq = &reqQ[pP->packet.Port - PORT_0][pSrvc->head & (ICS_REQ_DEPTH - 1)];
+		pReq->id = id;
+		pReq->flags = flags;
+		if (flags & REQ_COPY) {
+			memcpy(pReq->args, pP->packet.Data, pSrvc->len);
 		}
-		response = FRAME_OK;
+		pSrvc->head++;
+		pending |= (1u << (pP->packet.Port - PORT_0));
+		pP->response = FRAME_OK;
 	}
 }
 
@@ -253,3 +1279,53 @@ static bool isValidPort(ISMPport_t portNum)
 	}
 	return ret;
 }
+
+static const icsReg_t *regFind(uint8_t addr)
+{
+	const icsReg_t *pReg = NULL;
+	uint8_t idx;
+	for (idx = 0; idx < reg_num; idx++) {
+		if ((uint8_t)(addr - reg_map[idx].addr) < reg_map[idx].len) {
+			pReg = &reg_map[idx];
+			break;
+		}
+	}
+	return pReg;
+}
+
+static uint8_t regRead(void)
+{
+	uint8_t val = 0xFF;
+	const icsReg_t *pReg = regFind(reg_addr);
+	if ((pReg != NULL) && (pReg->flags & ICS_REG_RD)) {
+		uint8_t off = reg_addr - pReg->addr;
+		if (pReg->len <= ICS_REG_LATCH) {
+			/* Copy the whole value on the first byte read, so the
+			 * host never gets bytes of two different values. */
+			if ((pReg != reg_ent) || (off == 0)) {
+				if (pReg->pVar != NULL) {
+					memcpy(reg_latch, pReg->pVar, pReg->len);
+				}
+				else {
+					pReg->get(reg_latch);
+				}
+				reg_ent = pReg;
+			}
+			val = reg_latch[off];
+		}
+		else if (pReg->pVar != NULL) {
+			val = ((const uint8_t *)pReg->pVar)[off];
+		}
+	}
+	reg_addr++;
+	return val;
+}
+
+static void regWrite(uint8_t data)
+{
+	const icsReg_t *pReg = regFind(reg_addr);
+	if ((pReg != NULL) && (pReg->flags & ICS_REG_WR) && (pReg->pVar != NULL)) {
+		((uint8_t *)pReg->pVar)[reg_addr - pReg->addr] = data;
+	}
+	reg_addr++;
+}
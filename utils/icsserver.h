@@ -3,7 +3,7 @@
  * @author 	Mohit Rathod
  * Created: 10 10 2022, 09:26:16 pm
  * -----
- * Last Modified: 11 10 2022, 02:18:45 pm
+ * Last Modified: 19 10 2026, 12:59:21 am
  * Modified By  : Mohit Rathod
  * -----
  * MIT License
@@ -15,17 +15,90 @@
 #ifndef utils_icsserver_h
 #define utils_icsserver_h
 #include <stdint.h>
+#include <mosconfig.h>
 #include <utils/ismpframe.h>
 
 /* A maximum of 8 service ports are supported in this implementation. */
+#if MOS_GET(ICS_PORTS)
+#define PORT_NUM_MAX            MOS_GET(ICS_PORTS)
+#else
 #define PORT_NUM_MAX            (4)
+#endif
+
+/* Requests queued per port */
+#if MOS_GET(ICS_REQ_DEPTH)
+#define ICS_REQ_DEPTH           MOS_GET(ICS_REQ_DEPTH)
+#else
+#define ICS_REQ_DEPTH           (2)
+#endif
+
+/* Completions of requests sent with an ID awaiting collection */
+#if MOS_GET(ICS_DONE_DEPTH)
+#define ICS_DONE_DEPTH          MOS_GET(ICS_DONE_DEPTH)
+#else
+#define ICS_DONE_DEPTH          (4)
+#endif
+
+/* Bytes of the ring holding frames until ICS_run parses them */
+#if MOS_GET(ICS_RX_RING)
+#define ICS_RX_RING             MOS_GET(ICS_RX_RING)
+#else
+#define ICS_RX_RING             (32)
+#endif
 
 /* Server i2c address. */
 #define ICS_SERVER_ADDRESS      (0x40)
 
+/* Max. length of a batch frame (ID and records) */
+#if MOS_GET(ICS_BATCH_LEN)
+#define ICS_BATCH_LEN           MOS_GET(ICS_BATCH_LEN)
+#else
+#define ICS_BATCH_LEN           (12)
+#endif
+
+/* Frame counters, @see ICS_getStat */
+typedef enum
+{
+    ICS_STAT_OK,                /* FRAME_OK */
+    ICS_STAT_BUSY,              /* FRAME_OK_SRVC_BUSY */
+    ICS_STAT_HEADER,            /* HEADER_ERROR */
+    ICS_STAT_CRC,               /* CHECKSUM_ERROR */
+    ICS_STAT_SIZE,              /* FRAME_SIZE_ERROR */
+    ICS_STAT_PARAMS,            /* INVALID_PARAMS */
+    ICS_STAT_SRVC,              /* INVALID_SRVC */
+    ICS_STAT_PORT,              /* INVALID_PORT */
+    ICS_STAT_SEQ,               /* SEQUENCE_ERROR */
+    ICS_STAT_DROP,              /* dropped by the ISR, no room in the ring */
+    ICS_STAT_NUM
+} icsStat_t;
+
 /* Service (function) prototype */
 typedef uint8_t (*srvfn_t)(void *);
 
+/* Register values up to this size are read as one snapshot */
+#define ICS_REG_LATCH           (4)
+
+/* Register access flags */
+#define ICS_REG_RD              (0x01)
+#define ICS_REG_WR              (0x02)
+#define ICS_REG_RW              (ICS_REG_RD | ICS_REG_WR)
+
+/**
+ * @brief   Register map entry, a value spanning len consecutive
+ *          register addresses from addr.
+ *          Reads come from pVar, or from get() when pVar is NULL;
+ *          get() runs in the ISR and fills len (<= ICS_REG_LATCH)
+ *          bytes. Writes go straight to pVar from the ISR.
+ */
+typedef struct
+{
+    uint8_t addr;               /* first register */
+    uint8_t len;                /* registers (bytes) spanned */
+    uint8_t flags;              /* ICS_REG_RD, ICS_REG_WR */
+    void *pVar;                 /* backing variable, or NULL */
+    void (*get)(uint8_t *pDst); /* getter when pVar is NULL */
+} icsReg_t;
+
 /* SERVICES are later mapped to actual functions when applications calls
  * this utility and assigns a service to said register. This will become
  * the port to which an i2c master will write to get the desired action
@@ -33,19 +106,33 @@ typedef uint8_t (*srvfn_t)(void *);
 
 /**
  * @brief I2C Slave Server initialization
- *        Initialize the service arrays.
+ *        Initialize the service arrays and the frame parsers, the
+ *        transports are bound separately (@ref ICSi2c_init, and
+ *        ICSslip_init @see icsslip.h).
  * @param None
  * @return 0 on success, -1 otherwise
  */
 int ICSserver_init(void);
 
+/**
+ * @brief   Bind the server to the I2C slave at ICS_SERVER_ADDRESS.
+ *          Frames from each transport are parsed separately, so a
+ *          fragmented transfer on one isn't broken up by frames from
+ *          the other.
+ * @param   None
+ * @return  0 on success, -1 otherwise
+ */
+int ICSi2c_init(void);
+
 /**
  * @brief    ICS_addService function to add a service to the server.
  * 
  * @param service_fn    the name of the function which is to be registered.
  *                      @note All service functions must be of type 
  *                      @ref srvfn_t.
- * @param len           length of the parameter buffer.
+ * @param len           length of the parameter buffer (up to 255 bytes).
+ *                      A buffer longer than the frame payload is written
+ *                      with ISMP fragment frames, @see ismpframe.h
  * @param pbuf          buffer to store parameters for this service.
  * @param port          the ISMPport to which service_fn needs to be attached.
  *                      must be a valid ISMPport_t value
@@ -63,9 +150,145 @@ int ICS_addService(srvfn_t pService, const uint16_t len, void *pbuf, ISMPport_t
  */
 int ICS_delService(ISMPport_t portID);
 
+/**
+ * @brief   Give a service a multi-byte response.
+ *          Reading the port then returns the service return value
+ *          followed by len bytes the service wrote into
+ *          @ref ICS_rspBuffer, and optionally a CRC8 of those (any
+ *          port may be read with a trailing CRC, @see ismpframe.h).
+ *          The host always reads a consistent snapshot: the service
+ *          fills one copy while the other is read out, and a run
+ *          that would overwrite the copy being read is deferred until
+ *          the read is over. The copy is published when the service
+ *          calls @ref ICS_commitResponse, a run without it leaves the
+ *          host the last snapshot.
+ * @param   portID  port of the service.
+ * @param   pbuf    buffer of 2 * len bytes.
+ * @param   len     response length, 0 for the return value only.
+ * @return  0 on success, -1 otherwise.
+ */
+int ICS_setResponse(ISMPport_t portID, void *pbuf, uint8_t len);
+
+/**
+ * @brief   As @ref ICS_setResponse, with a single copy of the response
+ *          for services short of RAM. The service writes it in place
+ *          and every run publishes it: a run is still deferred while
+ *          the host reads the response, a read starting during a run
+ *          fails its CRC (the host reads again).
+ * @param   portID  port of the service.
+ * @param   pbuf    buffer of len bytes.
+ * @param   len     response length, 0 for the return value only.
+ * @return  0 on success, -1 otherwise.
+ */
+int ICS_setSingleResponse(ISMPport_t portID, void *pbuf, uint8_t len);
+
+/**
+ * @brief   Give a service a second parameter buffer.
+ *          Fragmented transfers to the port are then written to the
+ *          buffer the service isn't given, and the two are swapped
+ *          right before the service runs on the completed transfer.
+ *          Until then the service keeps its last arguments, also when
+ *          the transfer is abandoned half way.
+ * @param   portID  port of the service.
+ * @param   pbuf    buffer of len bytes (@see ICS_addService), NULL to
+ *                  go back to a single buffer.
+ * @return  0 on success, -1 otherwise.
+ * @note    The service must use the pointer it is passed, the buffer
+ *          given to ICS_addService only holds every other transfer.
+ */
+int ICS_setParamBuffer(ISMPport_t portID, void *pbuf);
+
+/**
+ * @brief   Buffer the service of a port writes its response in.
+ *          Only valid within the service.
+ * @param   portID  port of the service.
+ * @return  pointer to the response bytes, NULL if the port has no
+ *          multi-byte response.
+ */
+void *ICS_rspBuffer(ISMPport_t portID);
+
+/**
+ * @brief   Publish the response the service wrote, the host reads it
+ *          from the end of the run on. The buffer holds the last
+ *          published snapshot when the service starts, so it may
+ *          update only some of the bytes. Only valid within the
+ *          service.
+ * @param   portID  port of the service.
+ * @return  0 on success, -1 if the port has no multi-byte response.
+ */
+int ICS_commitResponse(ISMPport_t portID);
+
+/**
+ * @brief   Install a register map, served alongside the ISMP ports.
+ *          The host writes ISMP_REG_HEADER and a register address,
+ *          then either writes or (after a repeated START) reads any
+ *          number of bytes, the address incrementing after each.
+ *          A STOP ends the access.
+ *          Unmapped registers read as 0xFF and ignore writes.
+ * @param   pMap    table of entries, usually const (flash).
+ * @param   num     number of entries, 0 disables the register mode.
+ * @return  0 on success, -1 otherwise.
+ * @note    A value of up to ICS_REG_LATCH bytes is copied when its
+ *          first byte is read, so a multi-byte read is consistent.
+ */
+int ICS_setRegMap(const icsReg_t *pMap, uint8_t num);
+
+/**
+ * Transport interface, for links other than the I2C slave. These are
+ * called from the main loop, the frames are handled like those written
+ * over I2C and the services run by @ref ICS_run.
+ * @{
+ */
+/**
+ * @brief   Parse a whole ISMP frame received over another link.
+ * @param   pFrame  the frame, header to CRC.
+ * @param   len     frame length.
+ * @return  response to the frame, as the status read (0x55) over I2C.
+ */
+ISMPresponse_t ICS_putFrame(const uint8_t *pFrame, uint8_t len);
+
+/**
+ * @brief   Read the response of a port: service return value, its
+ *          multi-byte response (if any) and a CRC8 of both.
+ * @param   portID  port of the service.
+ * @param   pDst    buffer to copy the response to.
+ * @param   maxLen  size of pDst.
+ * @return  bytes copied, -1 if the port is invalid or pDst too short.
+ */
+int ICS_getResponse(ISMPport_t portID, uint8_t *pDst, uint8_t maxLen);
+
+/**
+ * @brief   Read the server descriptor, as ISMP_VERSION over I2C.
+ * @param   pDst    buffer to copy the descriptor and its CRC to.
+ * @param   maxLen  size of pDst.
+ * @return  bytes copied, -1 if pDst is too short.
+ */
+int ICS_getInfo(uint8_t *pDst, uint8_t maxLen);
+
+/**
+ * @brief   Collect the oldest completion, as ISMP_DONE_HEADER over I2C.
+ * @param   pDst    buffer of ISMP_DONE_LEN bytes, |Port|ID|Response|,
+ *                  all 0 when nothing has completed.
+ * @return  0 on success, -1 otherwise.
+ * @note    Safe alongside reads over I2C, each completion is
+ *          returned over one of the links.
+ */
+int ICS_getDone(uint8_t *pDst);
+/** @} Transport interface */
+
+/**
+ * @brief   Number of frames parsed with a given response, over all
+ *          links. Frames still in progress (ISMP_ONGOING) aren't
+ *          counted. The counts wrap around at 65536.
+ * @param   stat    the counter.
+ * @return  count, 0 for an invalid counter.
+ */
+uint16_t ICS_getStat(icsStat_t stat);
+
 /**
  * @brief   ICS Server service dispatcher.
- *          When a service (function) is due to run, this function will run it.
+ *          Parses the I2C frames left to it (@see MOS_CONFIG_ICS_DEFER),
+ *          then runs the services that are due.
  *          This function must be called (repeatedly) from the main loop.
  * @param   none.
  * @return none.
@@ -0,0 +1,85 @@
+/** 
+ * @file 	icsslip.c
+ * @author 	Mohit Rathod
+ * Created: 19 10 2026, 12:06:36 am
+ * -----
+ * Last Modified: 19 10 2026, 12:23:35 am
+ * Modified By  : Mohit Rathod
+ * -----
+ * MIT License
+ * https://opensource.org/licenses/MIT
+ * 
+ * @brief   SLIP/UART transport of the I2C Simple Server(ICS).
+ * 
+ */
+#include <utils/icsslip.h>
+#include <utils/slip.h>
+#include <dev/serial.h>
+
+/* Frame being received */
+static uint8_t rxBuf[SMP_FRAME_MAX];
+static slipDec_t rxDec;
+
+static void answer(int rxLen);
+
+int ICSslip_init()
+{
+    int ret = -1;
+#if MOS_USES(UART) == 1
+    slip_decInit(&rxDec, rxBuf, sizeof(rxBuf));
+    ret = 0;
+#endif
+    return ret;
+}
+
+void ICSslip_run()
+{
+    int len;
+    /* A frame may come in over several calls, the decoder keeps its
+     * state between them. */
+    while ((len = slip_decRun(&rxDec)) != SLIP_DEC_MORE) {
+        answer(len);
+    }
+}
+
+/**
+ * @brief   Handle the frame in rxBuf, or a dropped one, and send the
+ *          answer, it is built in rxBuf.
+ */
+static void answer(int rxLen)
+{
+    int len = 1;
+    if (rxLen == SLIP_DEC_LONG) {
+        rxBuf[0] = FRAME_SIZE_ERROR;
+    }
+    /* a bad escape, the frame is corrupt */
+    else if (rxLen == SLIP_DEC_BAD) {
+        rxBuf[0] = CHECKSUM_ERROR;
+    }
+    /* a port, its response is read */
+    else if ((rxLen == 1) && (rxBuf[0] >= PORT_0) &&
+             (rxBuf[0] < (PORT_0 + PORT_NUM_MAX))) {
+        len = ICS_getResponse(rxBuf[0], rxBuf, SMP_FRAME_MAX);
+        if (len < 0) {
+            rxBuf[0] = UNKNOWN_RESP;
+            len = 1;
+        }
+    }
+    /* or the server descriptor */
+    else if ((rxLen == 1) && (rxBuf[0] == ISMP_VERSION)) {
+        len = ICS_getInfo(rxBuf, SMP_FRAME_MAX);
+        if (len < 0) {
+            rxBuf[0] = UNKNOWN_RESP;
+            len = 1;
+        }
+    }
+    /* or the oldest completion */
+    else if ((rxLen == 1) && (rxBuf[0] == ISMP_DONE_HEADER)) {
+        ICS_getDone(rxBuf);
+        len = ISMP_DONE_LEN;
+    }
+    else {
+        rxBuf[0] = ICS_putFrame(rxBuf, rxLen);
+    }
+    slip_write(rxBuf, len);
+}
@@ -0,0 +1,42 @@
+/** 
+ * @file 	icsslip.h
+ * @author 	Mohit Rathod
+ * Created: 19 10 2026, 12:06:36 am
+ * -----
+ * Last Modified: 19 10 2026, 12:06:36 am
+ * Modified By  : Mohit Rathod
+ * -----
+ * MIT License
+ * https://opensource.org/licenses/MIT
+ * 
+ * @brief   SLIP/UART transport of the I2C Simple Server(ICS).
+ *          Serves the ports added with @ref ICS_addService over the
+ *          serial line, alongside the I2C slave. @see slipframe.h
+ * 
+ */
+#ifndef utils_icsslip_h
+#define utils_icsslip_h
+#include <mosconfig.h>
+#include <utils/icsserver.h>
+#include <utils/slipframe.h>
+
+/**
+ * @fn      int ICSslip_init(void);
+ * @brief   Initialize the SLIP transport of the ICS server.
+ * @param   void
+ * @return  0 on success, -1 otherwise
+ * @note    Needs the serial driver in Rx/Tx mode (MOS_CONFIG_UART 1).
+ */
+int ICSslip_init(void);
+
+/**
+ * @fn      void ICSslip_run(void);
+ * @brief   Decode the bytes received since the last call, and answer
+ *          the SMP frames completed. Like @ref ICS_run, this must be
+ *          called (repeatedly) from the main loop, ahead of ICS_run.
+ * @param   void
+ * @return  void
+ */
+void ICSslip_run(void);
+
+#endif /* utils_icsslip_h */
@@ -3,7 +3,7 @@
  * @author 	Mohit Rathod
  * Created: 08 10 2022, 03:44:44 pm
  * -----
- * Last Modified: 18 07 2024, 07:23:16 am
+ * Last Modified: 19 10 2026, 12:59:21 am
  * Modified By  : Mohit Rathod
  * -----
  * MIT License
@@ -25,6 +25,90 @@
  *  Port    => i2c Server Port      (1 Byte) 
  *  Data_x  => Payload Data         (Len-1 Byte)
  *  CRC     => CRC8 of the frame    (1 Byte) 
+ *  The frame is acknowledged by a status read: ISMP_RSP_HEADER is
+ *  written, then one byte read back (@see ISMPresponse_t). The frame
+ *  is parsed at its STOP, so a status read right after it returns
+ *  its response. A host should still poll while it reads
+ *  ISMP_ONGOING: the slave may leave parsing to its main loop
+ *  (MOS_CONFIG_ICS_DEFER, or a STOP while the loop was parsing).
+ * 
+ *  ISMP fragment frame format, streams a service buffer larger than
+ *  the payload of a frame over several frames.
+ * 
+ *        |Header|Length|<-------------Payload------------------>|Checksum|
+ *        +------+------+----+-----+-----+------+      +------+--------+
+ *        | Head | len  |Port| Seq |Total|Data_1|      |Data_n|   CRC  |
+ *        +------+------+----+-----+-----+------+  ''' +------+--------+
+ *           1      2      3    4     5     6             n+5    n+6
+ *  Head    => ISMP_FRAG_HEADER     (1 Byte)
+ *  Len     => n + 3                (1 Byte)
+ *  Seq     => Fragment number, 0 starts a new transfer (1 Byte)
+ *  Total   => Length of the service buffer (1 Byte)
+ *  Data_x  => Next n bytes of the buffer, n <= ISMP_FRAG_DATA_LEN
+ *  CRC     => CRC8 of the fragment (1 Byte)
+ *  Every fragment is acknowledged like a frame. A fragment with a bad
+ *  CRC is sent again with the same Seq. The service runs once Total
+ *  bytes have been received.
+ *  Bus time of a full fragment and its status read is 248 bit times,
+ *  ie ~6.4 kB/s at 100 kHz and ~25 kB/s at 400 kHz, against ~2.6 kB/s
+ *  and ~10 kB/s with 3 byte frames (slave latency not included).
+ * 
+ *  ISMP request frame, a frame tagged with an ID chosen by the host
+ * 
+ *        |Header|Length|<--------Payload--------------->|Checksum|
+ *        +------+------+----+----+------+      +------+--------+
+ *        | Head | len  |Port| ID |Data_1|      |Data_n|   CRC  |
+ *        +------+------+----+----+------+  ''' +------+--------+
+ *  Head    => ISMP_REQ_HEADER      (1 Byte)
+ *  Len     => n + 2                (1 Byte)
+ *  Requests are queued per port (FRAME_OK_SRVC_BUSY once the queue
+ *  is full) so the host may send several without waiting. Once run,
+ *  the port, ID and service response are held for the host, which
+ *  collects them in order by writing ISMP_DONE_HEADER and reading
+ *  3 bytes |Port|ID|Response| (all 0 when nothing has completed).
+ *  A completion is handed out with its first byte, a read ended early
+ *  loses it.
+ * 
+ *  Service response, read after writing the port
+ * 
+ *        read : |Response|Rsp_1|...|Rsp_m|CRC|
+ *  Rsp_x   => multi-byte response of the port, m = 0 unless set with
+ *             ICS_setResponse
+ *  CRC     => CRC8 of Response and Rsp_x, the host may stop before it
+ * 
+ *  Server descriptor, read after writing ISMP_VERSION
+ * 
+ *        read : |Ver|Payload|FragLen|BatchLen|Ports|Port_0|...|Port_k|CRC|
+ *        Port_x : |ArgLen|RspLen|Flags|
+ *  Ver     => ISMP_PROTO_VERSION
+ *  Payload => MAX_PAYLOAD_LEN, port and args of a service frame
+ *  FragLen => max. data bytes of a fragment (ISMP_FRAG_DATA_LEN)
+ *  BatchLen=> max. length of a batch frame, 0 when not supported
+ *  Ports   => number of ports, PORT_0 onwards
+ *  ArgLen  => arguments taken by the service of the port
+ *  RspLen  => bytes of its multi-byte response
+ *  Flags   => ISMP_PORT_ACTIVE, ISMP_PORT_FRAG, ISMP_PORT_BUF2
+ * 
+ *  ISMP register access, no length or CRC
+ * 
+ *        write: |ISMP_REG_HEADER|Addr|Data_0|Data_1|...
+ *        read : |ISMP_REG_HEADER|Addr| (Sr) read Data_0, Data_1, ...
+ *  Data_x goes to / comes from register Addr + x. A STOP ends the
+ *  access, the address is only kept across the repeated START.
+ * 
+ *  ISMP batch frame, several service requests under one CRC
+ * 
+ *        |Header|Length|<-----------Payload------------>|Checksum|
+ *        +------+------+----+------+-----+      +------+--------+
+ *        | Head | len  | ID |Port_1|Args |      |Port_k|Args|CRC |
+ *        +------+------+----+------+-----+  ''' +------+--------+
+ *  Head    => ISMP_BATCH_HEADER    (1 Byte)
+ *  Len     => ID and records       (1 Byte)
+ *  Args    => as many bytes as the service of the port takes
+ *  Up to 8 records, run in order by one ICS_run call. The completion
+ *  (@see ISMP_REQ_HEADER) reports port ISMP_BATCH_HEADER, the ID and
+ *  a mask with bit i set when record i returned non-zero, or didn't
+ *  run as its service was removed after the frame was received.
  * 
  */
 #ifndef utils_ismpframe_h
@@ -34,7 +118,21 @@
 #define MAX_PAYLOAD_LEN         (4)
 #define MAX_PACKET_LEN          (MAX_PAYLOAD_LEN + 3)
 #define ISMP_SVC_HEADER         (0x80)
+#define ISMP_FRAG_HEADER        (0x81)
+#define ISMP_FRAG_DATA_LEN      (16)
+#define ISMP_REQ_HEADER         (0x82)
+#define ISMP_REG_HEADER         (0x83)
+#define ISMP_BATCH_HEADER       (0x84)
 #define ISMP_RSP_HEADER         (0x55)
+#define ISMP_DONE_HEADER        (0x56)
+#define ISMP_DONE_LEN           (3)
+
+/* Server descriptor, @see ISMP_VERSION */
+#define ISMP_PROTO_VERSION      (0x02)
+#define ISMP_INFO_LEN(ports)    (5 + (3 * (ports)))
+#define ISMP_PORT_ACTIVE        (0x01)  /* a service is registered */
+#define ISMP_PORT_FRAG          (0x02)  /* args only fit fragment frames */
+#define ISMP_PORT_BUF2          (0x04)  /* fragments are double-buffered */
 
 typedef union
 {
@@ -61,6 +159,7 @@ typedef enum{
     ISMP_ONGOING,
     UNKNOWN_ERROR,
     UNKNOWN_RESP,
+    SEQUENCE_ERROR,
     ISMP_VERSION            = 0xC0
 } ISMPresponse_t;
 
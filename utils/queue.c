@@ -3,7 +3,7 @@
  * @author 	Mohit Rathod
  * Created: 17 09 2022, 09:03:11 pm
  * -----
- * Last Modified: 18 09 2022, 12:04:08 am
+ * Last Modified: 19 10 2026, 12:52:31 am
  * Modified By  : Mohit Rathod
  * -----
  * MIT License
@@ -12,16 +12,9 @@
  * @brief   Queue implementation (FIFO) to synchronise processes.
  */
 #include "queue.h"
-#include <mosconfig.h>
 
 typedef unsigned char uchar_t;
 
-#if MOS_GET(MAX_QUEUE)
-#define QUEUE_MAX               MOS_GET(MAX_QUEUE)
-#else
-#define QUEUE_MAX               (2)
-#endif
-
 /**
  * @brief Queue struct
  */
@@ -32,6 +25,8 @@ typedef struct
     uchar_t *buf;           /* queue buffer */
     volatile size_t head;   /* head of queue */
     volatile size_t tail;   /* tail of queue */
+    volatile size_t next;   /* tail once the element being read is out */
+    uint16_t drops;         /* elements refused, queue full */
 }queue_t;
 
 static queue_t _Q[QUEUE_MAX];
@@ -73,6 +68,8 @@ int q_init(qid_t *qID, q_attr_t *attr)
                 /* Initialize the queue internal variables */
                 _Q[qidx].head = 0;
                 _Q[qidx].tail = 0;
+                _Q[qidx].next = 0;
+                _Q[qidx].drops = 0;
                 _Q[qidx].elen = attr->elen;
                 _Q[qidx].qlen = attr->qlen;
                 _Q[qidx].buf = attr->buffer;
@@ -97,6 +94,9 @@ int qEnqueue(qid_t qID, const void *pdata)
             _Q[qID].head++;
             ret = 0;
         }
+        else {
+            _Q[qID].drops++;
+        }
     }
     return ret;
 }
@@ -108,10 +108,13 @@ int qDequeue(qid_t qID, void *pdata)
         ret = -1;
         /* Queue not empty? */
         if (isQEmpty(&(_Q[qID])) == 0) {
-            const size_t offset = (_Q[qID].tail & (_Q[qID].qlen - 1)) 
-                                    * _Q[qID].elen;
+            const size_t idx = _Q[qID].tail;
+            const size_t offset = (idx & (_Q[qID].qlen - 1)) * _Q[qID].elen;
+            /* claimed before the copy, a qReplace preempting it leaves
+             * the element alone; the slot is only freed after it */
+            _Q[qID].next = idx + 1;
             memcpy(pdata, &(_Q[qID].buf[offset]), _Q[qID].elen);
-            _Q[qID].tail++;
+            _Q[qID].tail = idx + 1;
             ret = 0;
         }
     }
@@ -126,3 +129,49 @@ int qCount(qid_t qID)
     }
     return count;
 }
+
+uint16_t qDrops(qid_t qID)
+{
+    uint16_t count = 0;
+    if (qID < QUEUE_MAX) {
+        count = _Q[qID].drops;
+    }
+    return count;
+}
+
+int qPeekLast(qid_t qID, void *pdata, size_t *pIdx)
+{
+    int ret = -2;
+    if (qID < QUEUE_MAX) {
+        ret = -1;
+        /* the element being read by qDequeue is gone already */
+        if (_Q[qID].head != _Q[qID].next) {
+            const size_t idx = _Q[qID].head - 1;
+            if (pdata != NULL) {
+                memcpy(pdata, &(_Q[qID].buf[(idx & (_Q[qID].qlen - 1))
+                                    * _Q[qID].elen]), _Q[qID].elen);
+            }
+            if (pIdx != NULL) {
+                *pIdx = idx;
+            }
+            ret = 0;
+        }
+    }
+    return ret;
+}
+
+int qReplace(qid_t qID, size_t idx, const void *pdata)
+{
+    int ret = -2;
+    if (qID < QUEUE_MAX) {
+        ret = -1;
+        /* still queued and not being read? */
+        if ((size_t)(idx - _Q[qID].next) <
+                                (size_t)(_Q[qID].head - _Q[qID].next)) {
+            const size_t offset = (idx & (_Q[qID].qlen - 1)) * _Q[qID].elen;
+            memcpy(&(_Q[qID].buf[offset]), pdata, _Q[qID].elen);
+            ret = 0;
+        }
+    }
+    return ret;
+}
@@ -3,7 +3,7 @@
  * @author 	Mohit Rathod
  * Created: 17 09 2022, 05:38:04 pm
  * -----
- * Last Modified: 21 09 2022, 09:46:44 pm
+ * Last Modified: 19 10 2026, 12:52:31 am
  * Modified By  : Mohit Rathod
  * -----
  * MIT License
@@ -15,6 +15,14 @@
 #define utils_queue_h
 #include <stdint.h>
 #include <string.h>
+#include <mosconfig.h>
+
+/* Queues supported */
+#if MOS_GET(MAX_QUEUE)
+#define QUEUE_MAX               MOS_GET(MAX_QUEUE)
+#else
+#define QUEUE_MAX               (2)
+#endif
 
 /**
  * @typedef typedef unsigned int qid_t;
@@ -82,5 +90,44 @@ int qDequeue(qid_t uQ, void *pdata);
  */
 int qCount(qid_t uQ);
 
+/**
+ * @fn      uint16_t qDrops(qid_t uQ);
+ * @brief   Number of elements refused by a full queue. The count
+ *          wraps around at 65536.
+ * @param   uQ      queue identifier
+ * @return  count, 0 for an invalid queue identifier.
+ */
+uint16_t qDrops(qid_t uQ);
+
+/**
+ * @fn      int qPeekLast(qid_t uQ, void *pdata, size_t *pIdx);
+ * @brief   Read the newest element of the queue without removing it.
+ * @param   uQ      queue identifier
+ * @param   pdata   pointer to load the element, may be NULL.
+ * @param   pIdx    pointer to load the running index of the element
+ *                  (for @ref qReplace), may be NULL.
+ * @return      0 on success,
+ *             -1 queue empty, or its last element is being read
+ *             -2 invalid queue identifier
+ */
+int qPeekLast(qid_t uQ, void *pdata, size_t *pIdx);
+
+/**
+ * @fn      int qReplace(qid_t uQ, size_t idx, const void *pdata);
+ * @brief   Overwrite an element that is still in the queue.
+ * @param   uQ      queue identifier
+ * @param   idx     running index of the element, @see qPeekLast
+ * @param   pdata   pointer to the new data.
+ * @return      0 on success,
+ *             -1 the element has been removed or is being read
+ *             -2 invalid queue identifier
+ * @note    qDequeue claims an element before copying it out, so a
+ *          qReplace preempting it (eg from an ISR) is refused with -1
+ *          and the caller queues the data instead. The reverse isn't
+ *          covered: qDequeue must not preempt qReplace (consumer in an
+ *          ISR, producer in the main loop).
+ */
+int qReplace(qid_t uQ, size_t idx, const void *pdata);
+
 
 #endif /* utils_queue_h */
@@ -3,7 +3,7 @@
  * @author 	Mohit Rathod
  * Created: 17 07 2024, 07:54:54 pm
  * -----
- * Last Modified: 18 07 2024, 02:06:15 pm
+ * Last Modified: 19 10 2026, 12:24:34 am
  * Modified By  : Mohit Rathod
  * -----
  * MIT License
@@ -15,62 +15,195 @@
 #include <utils/slip.h>
 #include <dev/serial.h>
 
+/* Bytes escaped on the stack per serial_send */
+#define SLIP_CHUNK          (16)
+
 /**
- * @brief SEND_PACKET: sends a packet of length "len", 
- *        starting at location "p".
- * @param[in] p - pointer to packet
- * @param[in] len - length of packet
- * @return None
+ * @brief   Escape one byte into pOut.
+ * @return  bytes written, 1 or 2.
  */
+static uint8_t encByte(uint8_t *pOut, uint8_t c)
+{
+    uint8_t n = 1;
+    /* END and ESC in the data are sent as two character codes, so the
+     * receiver does not take them for the real ones */
+    if (c == SLIP_END) {
+        pOut[0] = SLIP_ESC;
+        pOut[1] = SLIP_ESC_END;
+        n = 2;
+    } else if (c == SLIP_ESC) {
+        pOut[0] = SLIP_ESC;
+        pOut[1] = SLIP_ESC_ESC;
+        n = 2;
+    } else {
+        pOut[0] = c;
+    }
+    return n;
+}
+
+size_t slip_encLen(const slipSeg_t *pSeg, uint8_t nSeg)
+{
+    size_t len = 2;
+    uint8_t i;
+    for (; nSeg != 0; nSeg--, pSeg++) {
+        len += pSeg->len;
+        for (i = 0; i < pSeg->len; i++) {
+            if ((pSeg->p[i] == SLIP_END) || (pSeg->p[i] == SLIP_ESC)) {
+                len++;
+            }
+        }
+    }
+    return len;
+}
+
+size_t slip_encode(uint8_t *pOut, size_t size,
+                                        const slipSeg_t *pSeg, uint8_t nSeg)
+{
+    size_t len = slip_encLen(pSeg, nSeg);
+    size_t n = 0;
+    uint8_t i;
+    if (len > size) {
+        return 0;
+    }
+    /* an initial END flushes out any line noise at the receiver */
+    pOut[n++] = SLIP_END;
+    for (; nSeg != 0; nSeg--, pSeg++) {
+        for (i = 0; i < pSeg->len; i++) {
+            n += encByte(&pOut[n], pSeg->p[i]);
+        }
+    }
+    pOut[n++] = SLIP_END;
+    return n;
+}
+
+int slip_send(const slipSeg_t *pSeg, uint8_t nSeg)
+{
+    uint8_t chunk[SLIP_CHUNK];
+    uint8_t n = 0;
+    uint8_t i;
+    int ret = 0;
+    chunk[n++] = SLIP_END;
+    for (; nSeg != 0; nSeg--, pSeg++) {
+        for (i = 0; i < pSeg->len; i++) {
+            /* room for an escaped byte left? */
+            if (n > (SLIP_CHUNK - 2)) {
+                if (serial_send(chunk, n) != n) {
+                    ret = -1;
+                }
+                n = 0;
+            }
+            n += encByte(&chunk[n], pSeg->p[i]);
+        }
+    }
+    if (n == SLIP_CHUNK) {
+        if (serial_send(chunk, n) != n) {
+            ret = -1;
+        }
+        n = 0;
+    }
+    chunk[n++] = SLIP_END;
+    if (serial_send(chunk, n) != n) {
+        ret = -1;
+    }
+    return ret;
+}
+
 void slip_write(uint8_t *p, int8_t len)
 {
-	/* send an initial END character to flush out any data that may
-	 * have accumulated in the receiver due to line noise
-	 */
-	serial_putchar(SLIP_END);
+    slipSeg_t seg = { p, (uint8_t)len };
+    (void)slip_send(&seg, 1);
+}
 
-	/* for each byte in the packet, send the appropriate character
-	 * sequence
-	 */
-	while(len--)
-    {
-		switch(*p)
-        {
-		    /*  if it's the same code as an END character, we send a
-            *   special two character code so as not to make the
-            *   receiver think we sent an END
-            */
-            case SLIP_END:
-                serial_putchar(SLIP_ESC);
-                serial_putchar(SLIP_ESC_END);
-                break;
+/* Decoder states */
+enum
+{
+    DEC_DATA = 0,           /* in a frame */
+    DEC_ESC,                /* after an ESC */
+    DEC_DONE,               /* frame returned, the next byte starts one */
+    DEC_BAD,                /* bad escape, dropping until END */
+    DEC_LONG                /* overflow, dropping until END */
+};
 
-            /*  if it's the same code as an ESC character,
-            *   we send a special two character code so as not
-            *   to make the receiver think we sent an ESC
-            */
-            case SLIP_ESC:
-                serial_putchar(SLIP_ESC);
-                serial_putchar(SLIP_ESC_ESC);
-                break;
-            /* otherwise, we just send the character
-            */
-            default:
-                serial_putchar(*p);
-		}
-		p++;
-	}
+void slip_decInit(slipDec_t *pDec, uint8_t *pbuf, uint8_t size)
+{
+    pDec->buf = pbuf;
+    pDec->size = size;
+    pDec->len = 0;
+    pDec->state = DEC_DATA;
+    pDec->errors = 0;
+}
 
-	/* tell the receiver that we're done sending the packet
-	 */
-	serial_putchar(SLIP_END);
-	serial_putchar(SLIP_END);
+/**
+ * @brief   Store a decoded byte, or drop the frame if it's full.
+ */
+static void decStore(slipDec_t *pDec, uint8_t c)
+{
+    if (pDec->len < pDec->size) {
+        pDec->buf[pDec->len++] = c;
+        pDec->state = DEC_DATA;
+    } else {
+        pDec->state = DEC_LONG;
+        pDec->errors++;
+    }
+}
+
+int slip_decByte(slipDec_t *pDec, uint8_t c)
+{
+    int ret = SLIP_DEC_MORE;
+    if (pDec->state == DEC_DONE) {
+        pDec->len = 0;
+        pDec->state = DEC_DATA;
+    }
+    if (c == SLIP_END) {
+        /* an END right after an ESC is a protocol violation too */
+        if (pDec->state == DEC_ESC) {
+            pDec->state = DEC_BAD;
+            pDec->errors++;
+        }
+        if (pDec->state == DEC_BAD) {
+            ret = SLIP_DEC_BAD;
+        } else if (pDec->state == DEC_LONG) {
+            ret = SLIP_DEC_LONG;
+        } else {
+            ret = pDec->len;
+        }
+        pDec->state = DEC_DONE;
+    }
+    else if (pDec->state == DEC_ESC) {
+        if (c == SLIP_ESC_END) {
+            decStore(pDec, SLIP_END);
+        } else if (c == SLIP_ESC_ESC) {
+            decStore(pDec, SLIP_ESC);
+        } else {
+            pDec->state = DEC_BAD;
+            pDec->errors++;
+        }
+    }
+    else if (pDec->state == DEC_DATA) {
+        if (c == SLIP_ESC) {
+            pDec->state = DEC_ESC;
+        } else {
+            decStore(pDec, c);
+        }
+    }
+    /* DEC_BAD, DEC_LONG: the rest of the frame is dropped */
+    return ret;
+}
+
+int slip_decRun(slipDec_t *pDec)
+{
+    uint8_t c;
+    int ret = SLIP_DEC_MORE;
+    while ((ret == SLIP_DEC_MORE) && (serial_getchar(&c) == 0)) {
+        ret = slip_decByte(pDec, c);
+    }
+    return ret;
 }
 
 /**
  * @brief RECV_PACKET: reads a packet from UART buffer into
- *        the buffer located at "p".If more than len bytes 
- *        are received, the packet will be truncated.
+ *        the buffer located at "p". A packet longer than len
+ *        bytes or with a bad escape is dropped.
  * @param[out] p - pointer to packet buffer with copied data.
  * @param[in] len - length of packet buffer
  * @param[out] status - current packet status via pointer 
@@ -79,79 +212,21 @@ void slip_write(uint8_t *p, int8_t len)
  */
 int slip_read(uint8_t *p, int8_t len, pkt_status_t *status)
 {
-	uint8_t c;
-	int8_t received = 0;
-
-	/*  sit in a loop reading bytes until we put together
-	 *  a whole packet.Make sure not to copy them into 
-     *  the packet if we run out of room.
-	 */
-	while(1)
-    {
-	    /*  Ensure the UART receive buffer has atleast two bytes
-         * of data in it(for the ESC encoding case).
-         * If not, return and run in next call.  
-		 */
-        if( getSerialCount() < 2 )
-        {
-            *status = PENDING;
-            return received;
-        }
-        /* get a character to process */
-        serial_getchar(&c);
-
-        /* SLIP Decode */
-        switch(c)
-        {
-
-            /* if it's an END character then we're done with
-            * the packet
-            */
-            case SLIP_END:
-                /* a minor optimization: if there is no
-                * data in the packet, ignore it. This is
-                * meant to avoid bothering App with all
-                * the empty packets generated by the
-                * duplicate END characters which are in
-                * turn sent to try to detect line noise.
-                */
-                if(received)
-                {
-                    *status = COMPLETE;
-                    return received;
-                }
-                else {
-                    break;
-                }
-
-                /* if it's the same code as an ESC character, wait
-                * and get another character and then figure out
-                * what to store in the packet based on that.
-                */
-            case SLIP_ESC:
-                serial_getchar(&c);
-
-                /* if "c" is not one of these two, then we
-                    * have a protocol violation.  The best bet
-                    * seems to be to leave the byte alone and
-                    * just stuff it into the packet
-                    */
-                switch(c)
-                {
-                    case SLIP_ESC_END:
-                        c = SLIP_END;
-                        break;
-                    case SLIP_ESC_ESC:
-                        c = SLIP_ESC;
-                        break;
-                }
-
-            default:
-                /* Store the character */
-                if(received < len)
-                {
-                    p[received++] = c;
-                }
-        }
-	}
+    static slipDec_t dec;
+    int ret;
+    /* a new buffer starts a new packet */
+    if ((dec.buf != p) || (dec.size != (uint8_t)len)) {
+        slip_decInit(&dec, p, (uint8_t)len);
+    }
+    ret = slip_decRun(&dec);
+    if (ret > 0) {
+        *status = COMPLETE;
+    } else if (ret == SLIP_DEC_MORE) {
+        *status = PENDING;
+        ret = (dec.state == DEC_DONE) ? 0 : dec.len;
+    } else {
+        *status = STATUS_ERR;
+        ret = 0;
+    }
+    return ret;
 }
@@ -3,7 +3,7 @@
  * @author 	Mohit Rathod
  * Created: 17 07 2024, 06:43:21 pm
  * -----
- * Last Modified: 18 07 2024, 02:06:12 pm
+ * Last Modified: 19 10 2026, 12:24:34 am
  * Modified By  : Mohit Rathod
  * -----
  * MIT License
@@ -19,6 +19,7 @@
 #ifndef utils_slip_h
 #define utils_slip_h
 #include<stdint.h>
+#include<stddef.h>
 
 /**
  * @brief SLIP special character code 
@@ -39,6 +40,68 @@ typedef enum
   STATUS_ERR
 }pkt_status_t;
 
+/**
+ * @brief   Incremental SLIP decoder. It takes one byte at a time and
+ *          keeps its state between calls, so a frame may arrive in any
+ *          number of pieces. It can be fed from the UART Rx ISR (it
+ *          does not touch the serial driver) or in bulk from the
+ *          serial Rx queue with slip_decRun. One context per decoder.
+ */
+typedef struct
+{
+    uint8_t *buf;           /* frame buffer */
+    uint8_t size;           /* its size */
+    uint8_t len;            /* bytes of the current frame */
+    uint8_t state;          /* decoder state, private */
+    uint16_t errors;        /* frames dropped: bad escapes, overflows */
+} slipDec_t;
+
+/* slip_decByte/slip_decRun results besides the frame length */
+#define SLIP_DEC_MORE       (0)     /* no frame yet */
+#define SLIP_DEC_BAD        (-1)    /* frame dropped, bad escape */
+#define SLIP_DEC_LONG       (-2)    /* frame dropped, longer than buf */
+
+/**
+ * @brief   A piece of a frame to encode. A frame is given as a list of
+ *          pieces (eg header, payload, CRC) so it need not be put
+ *          together in one buffer first.
+ */
+typedef struct
+{
+    const uint8_t *p;       /* bytes */
+    uint8_t len;            /* number of bytes */
+} slipSeg_t;
+
+/**
+ * @fn      void slip_decInit(slipDec_t *, uint8_t *, uint8_t);
+ * @brief   Reset a decoder and its error count.
+ * @param   pDec    the decoder.
+ * @param   pbuf    frame buffer.
+ * @param   size    its size, longer frames are dropped.
+ */
+void slip_decInit(slipDec_t *pDec, uint8_t *pbuf, uint8_t size);
+
+/**
+ * @fn      int slip_decByte(slipDec_t *, uint8_t);
+ * @brief   Decode one received byte.
+ * @param   pDec    the decoder.
+ * @param   c       the byte.
+ * @return  frame length when c ends a frame, the frame is in buf until
+ *          the next byte. SLIP_DEC_MORE otherwise, empty frames (line
+ *          noise flushes) included. SLIP_DEC_BAD or SLIP_DEC_LONG when
+ *          c ends a dropped frame, it is counted in errors.
+ */
+int slip_decByte(slipDec_t *pDec, uint8_t c);
+
+/**
+ * @fn      int slip_decRun(slipDec_t *);
+ * @brief   Feed a decoder from the serial Rx queue until a frame ends
+ *          or the queue is empty.
+ * @param   pDec    the decoder.
+ * @return  as slip_decByte, SLIP_DEC_MORE once the queue is empty.
+ */
+int slip_decRun(slipDec_t *pDec);
+
 /**
  * @fn      int slip_read(uchar_t *, int8_t, pkt_status_t *);
  * @brief   RECV_PACKET: receives a packet into the buffer located at "p".
@@ -48,17 +111,51 @@ typedef enum
  * @return  Returns the number of bytes stored in the buffer.
  * 
  * @note:   
- *          If more than len bytes are received, the packet will be truncated.
+ *          Runs a decoder of its own on p, a packet longer than len
+ *          bytes or with a bad escape is dropped with STATUS_ERR.
  */
 int slip_read(uint8_t *p, int8_t len, pkt_status_t *status);
 
+/**
+ * @fn      size_t slip_encLen(const slipSeg_t *, uint8_t);
+ * @brief   Encoded length of a frame, END bytes included. Check it
+ *          against serial_txRoom to send a frame only when it fits.
+ * @param   pSeg    pieces of the frame.
+ * @param   nSeg    number of pieces.
+ * @return  bytes on the line.
+ */
+size_t slip_encLen(const slipSeg_t *pSeg, uint8_t nSeg);
+
+/**
+ * @fn      size_t slip_encode(uint8_t *, size_t, const slipSeg_t *, uint8_t);
+ * @brief   Encode a frame into a buffer: END, the escaped pieces, END.
+ * @param   pOut    output buffer.
+ * @param   size    its size.
+ * @param   pSeg    pieces of the frame.
+ * @param   nSeg    number of pieces.
+ * @return  encoded length, 0 if it does not fit (nothing is written).
+ */
+size_t slip_encode(uint8_t *pOut, size_t size,
+                                        const slipSeg_t *pSeg, uint8_t nSeg);
+
+/**
+ * @fn      int slip_send(const slipSeg_t *, uint8_t);
+ * @brief   Encode a frame straight onto the serial Tx ring, in chunks
+ *          (serial_send). A full ring is handled as MOS_UART_TX_FULL
+ *          says, a frame cut short there is dropped by the receiver.
+ * @param   pSeg    pieces of the frame.
+ * @param   nSeg    number of pieces.
+ * @return  0 on success, -1 if bytes were dropped.
+ */
+int slip_send(const slipSeg_t *pSeg, uint8_t nSeg);
+
 /**
  * @fn      void slip_write(uchar_t *p, int8_t len);
  * @param   p       pointer to the receive buffer
  * @param   len     length of packet
  * @return  void 
  * @brief   SEND_PACKET: sends a packet of length "len", starting at
- *          location "p".
+ *          location "p", @see slip_send.
  */
 void slip_write(uint8_t *p, int8_t len);
 
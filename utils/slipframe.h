@@ -3,75 +3,74 @@
  * @author 	Mohit Rathod
  * Created: 18 07 2024, 07:51:49 am
  * -----
- * Last Modified: 21 07 2024, 08:18:44 am
+ * Last Modified: 19 10 2026, 12:51:46 am
  * Modified By  : Mohit Rathod
  * -----
  * MIT License
  * https://opensource.org/licenses/MIT
  * 
  * @brief   SLIP Server Message Protocol(SMP) frame.
- *  
- *  SMP frame format
+ *          SMP carries ISMP over a serial line, each message in a
+ *          SLIP frame (@see slip.h). Every frame from the host gets
+ *          one frame back.
  * 
- *        |Header| Port |<--------Payload----------------->|Checksum|
- *        +------+------+------+------+------+      +------+--------+
- *        | Head | Port |Data_0|Data_1|Data_2|      |Data_n|   CRC  |
- *        +------+------+------+------+------+  ''' +------+--------+
- *           1      2      3       4      5            N+2     N+3
- *  Max Data payload = N bytes
- *  Max packet length = N + 3 bytes
- *  Head    => SMP Header           (1 Byte)
- *  Port    => SMP Server Port      (1 Byte) 
- *  Data_x  => Payload Data         (Len-1 Byte)
- *  CRC     => CRC8 of the frame    (1 Byte) 
+ *  SMP messages
+ * 
+ *        host                              server
+ *        |ISMP frame|              =>      |Response|
+ *        |Port|                    =>      |Response|Rsp_1|...|Rsp_m|CRC|
+ *        |ISMP_DONE_HEADER|        =>      |Port|ID|Response|
+ *        |ISMP_VERSION|            =>      |Server descriptor|CRC|
+ *  ISMP frame  => any ISMP frame, header to CRC (@see ismpframe.h)
+ *  Response    => as the status read (ISMP_RSP_HEADER) over I2C
+ *  Port        => as a service response read over I2C
+ * 
+ *  Max. message length = SMP_FRAME_MAX bytes before SLIP encoding,
+ *  longer frames are answered with FRAME_SIZE_ERROR.
  * 
  */
 #ifndef utils_slipframe_h
 #define utils_slipframe_h
 #include <stdint.h>
+#include <utils/ismpframe.h>
+#include <mosdefs.h>
+#include <mosconfig.h>
+#if MOS_USES(STATS)
+#include <mosstat.h>
+#endif
+#if MOS_USES(SMF_TRACE)
+#include <utils/smf.h>
+#endif
+
+/* the longest message: a fragment frame or the descriptor of 8 ports
+ * with its CRC, or a port response of the mOS statistics (@see
+ * mosstat.h) or the SMF trace (@see smf.h): the return value, the
+ * block and the CRC */
+#define SMP_INFO_MAX            (ISMP_INFO_LEN(PORT_MAX - PORT_0) + 1)
+#if MOS_USES(STATS)
+#define SMP_STATS_MAX           (MOSSTAT_LEN + 2)
+#else
+#define SMP_STATS_MAX           (0)
+#endif
+#if MOS_USES(SMF_TRACE)
+#define SMP_TRACE_MAX           (SMF_TRACE_RSP_LEN + 2)
+#else
+#define SMP_TRACE_MAX           (0)
+#endif
+#define SMP_MAX(a, b)           (((a) > (b)) ? (a) : (b))
+#define SMP_FRAME_MAX           SMP_MAX(SMP_INFO_MAX,                   \
+                                    SMP_MAX(SMP_STATS_MAX, SMP_TRACE_MAX))
 
-#define MAX_PAYLOAD_LEN         (5)
-#define MAX_PACKET_LEN          (MAX_PAYLOAD_LEN + 3)
-#define ISMP_SVC_HEADER         (0x80)
-#define ISMP_RSP_HEADER         (0x55)
+static_assert(SMP_FRAME_MAX >= (ISMP_FRAG_DATA_LEN + 6),
+                "SMP frame too short for a fragment frame");
 
 typedef union
 {
-    struct
-    {
-        uint8_t Header;
-        uint8_t Port;
-        uint8_t Data[MAX_PAYLOAD_LEN];
-        uint8_t Checksum;
-    };
-    uint8_t buf[MAX_PACKET_LEN];
+    ISMPframe_t ismp;
+    uint8_t buf[SMP_FRAME_MAX];
 } SLIPframe_t;
- 
-typedef enum{
-    FRAME_OK                = 0x00,
-    FRAME_OK_SRVC_BUSY,
-    HEADER_ERROR            = 0x51,
-    CHECKSUM_ERROR,
-    FRAME_SIZE_ERROR,
-    INVALID_PARAMS,
-    INVALID_SRVC,
-    INVALID_PORT,
-    ISMP_ONGOING,
-    UNKNOWN_ERROR,
-    UNKNOWN_RESP,
-    ISMP_VERSION            = 0xC0
-} SMPresponse_t;
 
-typedef enum port_enum{
-    PORT_0 = 0xA0,   // provides service 0
-    PORT_1,          // provides service 1
-    PORT_2,          // provides service 2
-    PORT_3,          // provides service 3
-    PORT_4,          // provides service 4
-    PORT_5,          // provides service 5
-    PORT_6,          // provides service 6
-    PORT_7,          // provides service 7
-    PORT_MAX
-} SMPport_t;
+typedef ISMPresponse_t SMPresponse_t;
+typedef ISMPport_t SMPport_t;
 
 #endif /* utils_slipframe_h */
@@ -3,7 +3,7 @@
  * @author 	Mohit Rathod
  * Created: 26 09 2022, 01:49:19 pm
  * -----
- * Last Modified: 26 09 2022, 04:01:45 pm
+ * Last Modified: 19 10 2026, 12:51:46 am
  * Modified By  : Mohit Rathod
  * -----
  * MIT License
@@ -13,65 +13,254 @@
  * 
  */
 #include "smf.h"
-#include <utils/queue.h>
+#include <mossch.h>
+#if MOS_USES(SMF_TRACE)
+#include <string.h>
+#include <utils/slip.h>
+#include <utils/icsserver.h>
+#endif
 
+/* registered state machine instances */
+static smf_t *_smList[SMF_INSTANCES];
+static uint8_t _smNum;
+
+#if MOS_USES(SMF_TRACE)
 typedef struct
 {
-    pAction_t action[STATESMAX][EVENTSMAX];
-} stateMachine_t;
+    uint16_t tick;
+    uint8_t event;
+    uint8_t state;
+} smfTrace_t;
+
+static smfTrace_t _trace[SMF_TRACE_LEN];
+static uint16_t _traceHead;         /* transitions logged so far */
+static ISMPport_t _tracePort;       /* ICS port serving the trace */
+/* response snapshots of the ICS port, the copy read stays intact */
+static uint8_t _traceRsp[2 * SMF_TRACE_RSP_LEN];
+
+/* Log a transition, a handful of instructions when enabled */
+#define SMF_TRACE(idx, cur, ev, nxt)                                    \
+    do {                                                                \
+        smfTrace_t *pRec = &_trace[_traceHead++ & (SMF_TRACE_LEN - 1)]; \
+        pRec->tick = mossTicks();                                       \
+        pRec->event = ((idx) << 4) | ((ev) - EVENT_0);                  \
+        pRec->state = (((cur) - STATE_0) << 4) | ((nxt) - STATE_0);     \
+    } while (0)
 
+static uint8_t SMF_traceService(void *pargs);
+static uint8_t SMF_traceCopy(uint8_t *pDst);
+#else
+#define SMF_TRACE(idx, cur, ev, nxt)    do { } while (0)
+#endif /* MOS_USES(SMF_TRACE) */
 
-#define EVENT_QUEUE_LEN         (8)
+#if MOS_USES(SMF_COALESCE)
+/* Class of an event, each event is a class of its own without a table */
+#define SMF_CLASS(pSM, ev)                                              \
+    (((pSM)->pClass != NULL) ? (pSM)->pClass[(ev) - EVENT_0] : ((ev) - EVENT_0))
 
-static qid_t event_qID;
-static uint8_t event_qMEM[EVENT_QUEUE_LEN];
-static state_t _smState;
-static stateMachine_t SM;
+/* The queued event of the class has been taken off the queue */
+#define SMF_DEQUEUED(pSM, ev)                                           \
+    do {                                                                \
+        uint8_t cls = SMF_CLASS(pSM, ev);                               \
+        if (cls < EVENTSMAX) {                                          \
+            (pSM)->pendMask &= ~(1u << cls);                            \
+        }                                                               \
+    } while (0)
 
+static int SMF_coalesce(smf_t *pSM, const uint8_t *pEvent);
+static void SMF_queued(smf_t *pSM, uint8_t uEvent);
+#else
+#define SMF_DEQUEUED(pSM, ev)           do { } while (0)
+#define SMF_coalesce(pSM, pEvent)       (-1)
+#define SMF_queued(pSM, uEvent)         do { } while (0)
+#endif /* MOS_USES(SMF_COALESCE) */
 
 static int SMF_getEvent(qid_t qID, event_t *pEvent);
-static state_t SMF_transition(state_t uState, event_t uEvent);
+static state_t SMF_transition(const smf_t *pSM, event_t uEvent);
+static void SMF_armTimeout(smf_t *pSM);
 
-int SMF_init(state_t iState)
+int SMF_init(smf_t *pSM, const smfTable_t *pTable, state_t iState, void *pCtx)
 {
-    q_attr_t attr = {
-        .elen = (event_qMEM[0]),
-        .qlen = ARRAY_SIZE(event_qMEM),
-        .buffer = event_qMEM
-    };
-    /* set the intitial state of the state machine */
-    _smState = iState;
-    return q_init(&event_qID, &attr);
+    int ret = -1;
+    if ((pSM != NULL) && (pTable != NULL) && (_smNum < SMF_INSTANCES) &&
+        (iState >= STATE_0) && (iState < MAX_States)) {
+        q_attr_t attr = {
+            .elen = sizeof(pSM->qMEM[0]),
+            .qlen = ARRAY_SIZE(pSM->qMEM),
+            .buffer = pSM->qMEM
+        };
+        ret = q_init(&(pSM->qID), &attr);
+        if (ret == 0) {
+            pSM->pTable = pTable;
+            pSM->pCtx = pCtx;
+            /* set the intitial state of the state machine */
+            pSM->state = iState;
+            SMF_armTimeout(pSM);
+#if MOS_USES(SMF_COALESCE)
+            pSM->coalesce = SMF_COALESCE_NONE;
+            pSM->pendMask = 0;
+            pSM->pClass = NULL;
+#endif
+            _smList[_smNum++] = pSM;
+        }
+    }
+    return ret;
 }
 
-int SMF_addState(state_t uState, evAction_t *ptr, size_t len)
+int SMF_addState(smfTable_t *pTable, state_t uState, const evAction_t *ptr,
+                                                                size_t len)
 {
     int ret = -1;
-    if ((ptr != NULL) && (uState >= STATE_0) && (uState < MAX_States)) {
+    if ((pTable != NULL) && (ptr != NULL) &&
+        (uState >= STATE_0) && (uState < MAX_States)) {
+        ret = 0;
         while (len--) {
-            SM.action[uState - STATE_0][((ptr+len)->event) - EVENT_0] 
+            if (((ptr+len)->event >= EVENT_0) &&
+                ((ptr+len)->event < MAX_Events)) {
+                pTable->action[uState - STATE_0][((ptr+len)->event) - EVENT_0]
                                         = (ptr+len)->action;
+            } else {
+                ret = -1;
+            }
         }
+    }
+    return ret;
+}
+
+int SMF_setTimeout(smfTable_t *pTable, state_t uState, uint16_t ms,
+                                                        event_t uEvent)
+{
+    int ret = -1;
+    if ((pTable != NULL) && (uState >= STATE_0) && (uState < MAX_States) &&
+        (uEvent >= EVENT_0) && (uEvent < MAX_Events)) {
+        pTable->timeout[uState - STATE_0].ms = ms;
+        pTable->timeout[uState - STATE_0].event = uEvent;
         ret = 0;
     }
     return ret;
 }
 
-state_t SMF_getState()
+pAction_t SMF_getAction(const smfTable_t *pTable, state_t uState,
+                                                        event_t uEvent)
 {
-    return _smState;
+    pAction_t action = NULL;
+    if ((pTable != NULL) && (uState >= STATE_0) && (uState < MAX_States) &&
+        (uEvent >= EVENT_0) && (uEvent < MAX_Events)) {
+        action = pTable->action[uState - STATE_0][uEvent - EVENT_0];
+    }
+    return action;
 }
 
-int SMF_putEvent(const uint8_t *pEvent)
+state_t SMF_getState(const smf_t *pSM)
 {
-    return qEnqueue(event_qID, pEvent);
+    return pSM->state;
 }
 
+int SMF_putEvent(smf_t *pSM, const uint8_t *pEvent)
+{
+    int ret = -1;
+    /* Only events known to the framework are queued */
+    if ((*pEvent >= EVENT_0) && (*pEvent < MAX_Events)) {
+        ret = SMF_coalesce(pSM, pEvent);
+        if (ret != 0) {
+            ret = qEnqueue(pSM->qID, pEvent);
+            if (ret == 0) {
+                SMF_queued(pSM, *pEvent);
+            }
+        }
+    }
+    return ret;
+}
+
+#if MOS_USES(SMF_COALESCE)
+int SMF_setCoalesce(smf_t *pSM, smfCoalesce_t rule, const uint8_t *pClass)
+{
+    int ret = -1;
+    if ((pSM != NULL) && (rule <= SMF_COALESCE_LATEST)) {
+        pSM->coalesce = SMF_COALESCE_NONE;
+        pSM->pendMask = 0;
+        pSM->pClass = pClass;
+        pSM->coalesce = rule;
+        ret = 0;
+    }
+    return ret;
+}
+
+/**
+ * @brief   Apply the coalescing rule of an instance to a new event.
+ * @return  0 when the event has been coalesced, -1 if it must be queued.
+ */
+static int SMF_coalesce(smf_t *pSM, const uint8_t *pEvent)
+{
+    int ret = -1;
+    uint8_t cls = SMF_CLASS(pSM, *pEvent);
+    uint8_t last;
+    size_t idx;
+    if (cls < EVENTSMAX) {
+        switch (pSM->coalesce) {
+        case SMF_COALESCE_DROP_DUP:
+            if ((qPeekLast(pSM->qID, &last, NULL) == 0) && (last == *pEvent)) {
+                ret = 0;
+            }
+            break;
+        case SMF_COALESCE_REPLACE_CLASS:
+            if (pSM->pendMask & (1u << cls)) {
+                ret = qReplace(pSM->qID, pSM->pendIdx[cls], pEvent);
+            }
+            break;
+        case SMF_COALESCE_LATEST:
+            /* an exempt event is never overwritten */
+            if ((qPeekLast(pSM->qID, &last, &idx) == 0) &&
+                (SMF_CLASS(pSM, last) < EVENTSMAX)) {
+                ret = qReplace(pSM->qID, idx, pEvent);
+            }
+            break;
+        default:
+            break;
+        }
+    }
+    return ret;
+}
+
+/**
+ * @brief   Note the queue position of a newly queued event.
+ */
+static void SMF_queued(smf_t *pSM, uint8_t uEvent)
+{
+    uint8_t cls = SMF_CLASS(pSM, uEvent);
+    if ((pSM->coalesce == SMF_COALESCE_REPLACE_CLASS) && (cls < EVENTSMAX) &&
+        (qPeekLast(pSM->qID, NULL, &(pSM->pendIdx[cls])) == 0)) {
+        pSM->pendMask |= (1u << cls);
+    }
+}
+#endif /* MOS_USES(SMF_COALESCE) */
+
 void SMF_Run()
 {
+    uint8_t idx;
+    smf_t *pSM;
+    state_t uState;
     event_t uEvent;
-    if (SMF_getEvent(event_qID, &uEvent) == 0) {
-        _smState = SMF_transition( _smState, uEvent);
+    for (idx = 0; idx < _smNum; idx++) {
+        pSM = _smList[idx];
+        /* Has the machine overstayed in its current state? */
+        if ((pSM->tmoTicks != 0) &&
+            ((uint16_t)(mossTicks() - pSM->tmoStart) >= pSM->tmoTicks)) {
+            pSM->tmoTicks = 0;
+            uEvent = (event_t)pSM->pTable->timeout[pSM->state - STATE_0].event;
+        }
+        else if (SMF_getEvent(pSM->qID, &uEvent) == 0) {
+            SMF_DEQUEUED(pSM, uEvent);
+        }
+        else {
+            continue;
+        }
+        uState = SMF_transition(pSM, uEvent);
+        SMF_TRACE(idx, pSM->state, uEvent, uState);
+        if (uState != pSM->state) {
+            pSM->state = uState;
+            SMF_armTimeout(pSM);
+        }
     }
 }
 
@@ -83,10 +272,85 @@ static int SMF_getEvent(qid_t qID, event_t *pEvent)
     return ret;
 }
 
-static state_t SMF_transition(state_t uState, event_t uEvent)
+static void SMF_armTimeout(smf_t *pSM)
+{
+    uint16_t ms = pSM->pTable->timeout[pSM->state - STATE_0].ms;
+    pSM->tmoStart = mossTicks();
+    /* round up, a timeout never expires early */
+    pSM->tmoTicks = (ms / MOSS_TICK_MS) + ((ms % MOSS_TICK_MS) ? 1 : 0);
+}
+
+static state_t SMF_transition(const smf_t *pSM, event_t uEvent)
 {
-    if (SM.action[uState - STATE_0][uEvent - EVENT_0] != NULL) {
-        uState = SM.action[uState - STATE_0][uEvent - EVENT_0]();
+    state_t uState = pSM->state;
+    pAction_t action = pSM->pTable->action[uState - STATE_0][uEvent - EVENT_0];
+    if (action != NULL) {
+        uState = action(pSM->pCtx);
     }
     return uState;
 }
+
+#if MOS_USES(SMF_TRACE)
+int SMF_traceInit(ISMPport_t portID)
+{
+    int ret = -1;
+    if (ICS_addService(SMF_traceService, 0, NULL, portID) == 0) {
+        _tracePort = portID;
+        ret = ICS_setResponse(portID, _traceRsp, SMF_TRACE_RSP_LEN);
+    }
+    return ret;
+}
+
+void SMF_traceDump(void)
+{
+    uint8_t frame[1 + SMF_TRACE_RSP_LEN];
+    uint8_t num;
+    frame[0] = SMF_TRACE_MAGIC;
+    num = SMF_traceCopy(&frame[1]);
+    slip_write(frame, 2 + (num * SMF_TRACE_REC_LEN));
+}
+
+/**
+ * @brief   Trace service, copies the trace into the response of its
+ *          port. The records are read out of the snapshot, the ring
+ *          may move on meanwhile.
+ * @return  number of records copied.
+ */
+static uint8_t SMF_traceService(void *pargs)
+{
+    uint8_t num;
+    IGNORE(pargs);
+    num = SMF_traceCopy(ICS_rspBuffer(_tracePort));
+    ICS_commitResponse(_tracePort);
+    return num;
+}
+
+/**
+ * @brief   Copies the trace to pDst in the trace format: the record
+ *          count, then the records oldest first. The bytes past the
+ *          last record are zeroed, SMF_TRACE_RSP_LEN bytes in all.
+ * @return  number of records copied.
+ */
+static uint8_t SMF_traceCopy(uint8_t *pDst)
+{
+    const uint16_t head = _traceHead;
+    const uint8_t num = (head < SMF_TRACE_LEN) ? head : SMF_TRACE_LEN;
+    uint8_t rec;
+    *pDst++ = num;
+    for (rec = 0; rec < SMF_TRACE_LEN; rec++) {
+        if (rec < num) {
+            const smfTrace_t *pRec = &_trace[(head - num + rec) &
+                                                    (SMF_TRACE_LEN - 1)];
+            *pDst++ = pRec->tick & 0xFF;
+            *pDst++ = pRec->tick >> 8;
+            *pDst++ = pRec->event;
+            *pDst++ = pRec->state;
+        }
+        else {
+            memset(pDst, 0, SMF_TRACE_REC_LEN);
+            pDst += SMF_TRACE_REC_LEN;
+        }
+    }
+    return num;
+}
+#endif /* MOS_USES(SMF_TRACE) */
@@ -3,7 +3,7 @@
  * @author 	Mohit Rathod
  * Created: 24 09 2022, 10:49:14 pm
  * -----
- * Last Modified: 26 09 2022, 04:01:35 pm
+ * Last Modified: 19 10 2026, 12:52:31 am
  * Modified By  : Mohit Rathod
  * -----
  * MIT License
@@ -12,12 +12,23 @@
  * @brief   State Machine Framework(SMF) API
  *          SMF is an application agnostic framework that provides
  *          an easy way to integrate state-machine into an mOS app.
+ * @details A state machine is split in two parts:
+ *          -> a transition table (@ref smfTable_t) that lists the
+ *              action for every (state, event) pair. It holds no
+ *              run-time data, so identical machines can share one
+ *              const table placed in flash.
+ *          -> an instance (@ref smf_t) that holds the current state,
+ *              the event queue and a user context handed to every
+ *              action of that machine.
+ *          Every initialized instance is registered with the SMF
+ *          and served in a round-robin manner by @ref SMF_Run.
  */
 #ifndef utils_state_machine_framework_h
 #define utils_state_machine_framework_h
 #include <stdint.h>
 #include <stddef.h>
 #include <mosconfig.h>
+#include <utils/queue.h>
 
 #if MOS_GET(SMF_MAX_EVENTS)
 #define EVENTSMAX               MOS_GET(SMF_MAX_EVENTS)
@@ -29,6 +40,42 @@
 #else
 #define STATESMAX               (5)
 #endif
+#if MOS_GET(SMF_MAX_INSTANCES)
+#define SMF_INSTANCES           MOS_GET(SMF_MAX_INSTANCES)
+#else
+#define SMF_INSTANCES           (2)
+#endif
+
+/* size of the event queue of an instance (must be a power of 2) */
+#define SMF_EVENT_QUEUE_LEN     (8)
+
+#if MOS_USES(SMF_TRACE)
+#if (MOS_GET(SMF_TRACE_LEN) != 8) && (MOS_GET(SMF_TRACE_LEN) != 16)
+#define MOS_SMF_TRACE_LEN       (16)
+#warning "Invalid SMF trace length, reverting to default length(16)."
+#endif
+#define SMF_TRACE_LEN           MOS_GET(SMF_TRACE_LEN)
+#include <utils/ismpframe.h>
+#endif /* MOS_USES(SMF_TRACE) */
+
+/**
+ * SMF transition trace format, used by the UART dump and the ICS
+ * service alike (multi-byte values are little endian).
+ *
+ *        | Magic | Count |<----- Record 0 ----->|     |<- Record n -->|
+ *        +-------+-------+----+----+-----+-----+     +---------------+
+ *        |  'T'  |   n   |Tick|Tick|Event|State| ''' |      ...      |
+ *        +-------+-------+----+----+-----+-----+     +---------------+
+ *  Magic   => only in the UART (SLIP) dump         (1 Byte)
+ *  Count   => number of records, oldest first      (1 Byte)
+ *  Tick    => mossTicks() at the transition        (2 Byte)
+ *  Event   => instance[7:4] | event - EVENT_0[3:0] (1 Byte)
+ *  State   => state - STATE_0[7:4] | next - STATE_0[3:0] (1 Byte)
+ */
+#define SMF_TRACE_MAGIC         ('T')
+#define SMF_TRACE_REC_LEN       (4)
+/* ICS response of the trace port: count and every record slot */
+#define SMF_TRACE_RSP_LEN       (1 + (SMF_TRACE_LEN * SMF_TRACE_REC_LEN))
 
 /**
  * @brief   Event data type
@@ -52,7 +99,7 @@ typedef enum EventEnum
  * @brief   State data type
  * @note    Add enumeration members when num of states
  *          is greater than 8.
- */ 
+ */
 typedef enum StateEnum
 {
     STATE_0 = 0x40,
@@ -68,60 +115,211 @@ typedef enum StateEnum
 
 /**
  * @brief   EventHandler (Action) function prototype
- * 
+ *          pCtx is the user context of the instance the action
+ *          runs for, @see SMF_init.
  */
-typedef state_t (*pAction_t)(void);
+typedef state_t (*pAction_t)(void *pCtx);
 
 /**
  * @brief   Event-Action data structure, lists event and its corresponding
  *          action for a given state.
  */
-typedef struct 
+typedef struct
 {
     event_t event;       /* event */
     pAction_t action;    /* eventHandler for the above event */
 } evAction_t;
 
 /**
- * @fn      int SMF_init(state_t iState);
- * @brief   Initialize the State Machine Framework, also sets up the initial
- *          state of the generic state machine.
- * @param   iState  initial state of the state machine to be implemented.
+ * @brief   State timeout, the event is injected once the machine has
+ *          stayed 'ms' milliseconds in the state. A 0 ms timeout is
+ *          disabled.
+ */
+typedef struct
+{
+    uint16_t ms;        /* time allowed in the state */
+    uint8_t event;      /* event injected on expiry */
+} smfTimeout_t;
+
+/**
+ * @brief   State transition table, holds the action of every
+ *          (state, event) pair and the timeout of every state of
+ *          a state machine.
+ * @note    A const table can be built with designated initializers
+ *          and the SMF_STATE()/SMF_EVENT() index helpers, eg
+ *          const smfTable_t tbl = { .action = {
+ *              SMF_STATE(STATE_0) = { SMF_EVENT(EVENT_1) = fn }, },
+ *              .timeout = { SMF_STATE(STATE_0) = { 500, EVENT_2 }, }};
+ */
+typedef struct
+{
+    pAction_t action[STATESMAX][EVENTSMAX];
+    smfTimeout_t timeout[STATESMAX];
+} smfTable_t;
+
+/* Index helpers for designated initializers of a smfTable_t */
+#define SMF_STATE(s)            [(s) - STATE_0]
+#define SMF_EVENT(e)            [(e) - EVENT_0]
+
+#if MOS_USES(SMF_COALESCE)
+/**
+ * @brief   Event coalescing rule of an instance, applied in O(1) when
+ *          an event is put on the queue. A coalesced event isn't
+ *          queued and SMF_putEvent reports success.
+ */
+typedef enum
+{
+    SMF_COALESCE_NONE = 0,      /* queue every event */
+    SMF_COALESCE_DROP_DUP,      /* drop an event equal to the newest queued */
+    SMF_COALESCE_REPLACE_CLASS, /* overwrite the queued event of its class */
+    SMF_COALESCE_LATEST         /* overwrite the newest queued event */
+} smfCoalesce_t;
+
+/* Class of events that are always queued and never overwritten */
+#define SMF_CLASS_NONE          (0xFF)
+#endif /* MOS_USES(SMF_COALESCE) */
+
+/**
+ * @brief   State machine instance.
+ * @note    Members are private to the framework, use the SMF_ APIs.
+ */
+typedef struct
+{
+    const smfTable_t *pTable;           /* transition table */
+    void *pCtx;                         /* user context for actions */
+    volatile state_t state;             /* current state */
+    uint16_t tmoStart;                  /* tick the state was entered */
+    uint16_t tmoTicks;                  /* state timeout, 0 => disarmed */
+    qid_t qID;                          /* event queue */
+    uint8_t qMEM[SMF_EVENT_QUEUE_LEN];  /* event queue buffer */
+#if MOS_USES(SMF_COALESCE)
+    uint8_t coalesce;                   /* smfCoalesce_t rule */
+    volatile uint8_t pendMask;          /* classes with a queued event */
+    const uint8_t *pClass;              /* class of every event */
+    size_t pendIdx[EVENTSMAX];          /* queue index of each class */
+#endif
+} smf_t;
+
+/**
+ * @fn      int SMF_init(smf_t *, const smfTable_t *, state_t, void *);
+ * @brief   Initialize a state machine instance, sets up its initial
+ *          state and registers it with the State Machine Framework.
+ * @param   pSM     instance to initialize.
+ * @param   pTable  transition table of the instance, may be shared.
+ * @param   iState  initial state of the state machine.
+ * @param   pCtx    user context passed on to the actions (may be NULL).
  * @return  0 on success, -1 otherwise
+ * @note    Every instance takes a queue, see MOS_MAX_QUEUE.
  */
-int SMF_init(state_t iState);
+int SMF_init(smf_t *pSM, const smfTable_t *pTable, state_t iState, void *pCtx);
 
 /**
- * @fn      int SMF_addState(state_t uState, stateTransition_t *ptr);
- * @brief   Add a state and its transition rules to the SM Framework
+ * @fn      int SMF_addState(smfTable_t *, state_t, const evAction_t *, size_t);
+ * @brief   Add a state and its transition rules to a transition table.
+ *          Useful when the table is built at run-time.
+ * @param   pTable  the table to add the state to.
  * @param   uState  the state to add.
- * @param   ptr     pointer to state transition table of the above state. 
+ * @param   ptr     pointer to event-action pairs of the above state.
+ * @param   len     number of event-action pairs.
  * @return  0 on success, -1 otherwise
  */
-int SMF_addState(state_t uState, evAction_t *ptr, size_t len);
+int SMF_addState(smfTable_t *pTable, state_t uState, const evAction_t *ptr,
+                                                                size_t len);
+
+/**
+ * @fn      int SMF_setTimeout(smfTable_t *, state_t, uint16_t, event_t);
+ * @brief   Set the timeout of a state in a transition table.
+ *          Useful when the table is built at run-time.
+ * @param   pTable  the table holding the state.
+ * @param   uState  the state to guard.
+ * @param   ms      time allowed in the state, 0 disables the timeout.
+ * @param   uEvent  event injected when the time in the state runs out.
+ * @return  0 on success, -1 otherwise
+ */
+int SMF_setTimeout(smfTable_t *pTable, state_t uState, uint16_t ms,
+                                                        event_t uEvent);
+
+/**
+ * @fn      pAction_t SMF_getAction(const smfTable_t *, state_t, event_t);
+ * @brief   Look up the action of a (state, event) pair in a table.
+ * @param   pTable  the table.
+ * @param   uState  the state.
+ * @param   uEvent  the event.
+ * @return  the action, NULL if the event isn't handled in the state.
+ */
+pAction_t SMF_getAction(const smfTable_t *pTable, state_t uState,
+                                                        event_t uEvent);
+
+/**
+ * @fn      state_t SMF_getState(const smf_t *pSM);
+ * @brief   Fetches the current state of a state machine instance.
+ * @param   pSM     the instance.
+ * @return  state
+ */
+state_t SMF_getState(const smf_t *pSM);
 
 /**
- * @fn      state_t SMF_getState(void);
- * @brief   Fetches the current state of the State Machine implemented
- *          via the SM Framework.
- * @return  state 
+ * @fn      int SMF_putEvent(smf_t *pSM, const uint8_t *pEvent);
+ * @brief   Add an event on the event queue of an instance.
+ * @param   pSM     the instance.
+ * @param   pEvent  Event to add
+ * @return  0 on success (queued or coalesced), -1 otherwise
  */
-state_t SMF_getState(void);
+int SMF_putEvent(smf_t *pSM, const uint8_t *pEvent);
 
+#if MOS_USES(SMF_COALESCE)
 /**
- * @fn      int SMF_putEvent(const uint8_t *pEvent);
- * @brief   Add an event on the SM Framework event queue.
- * @param   pEvent Event to add
+ * @fn      int SMF_setCoalesce(smf_t *, smfCoalesce_t, const uint8_t *);
+ * @brief   Set the event coalescing rule of an instance.
+ * @param   pSM     the instance.
+ * @param   rule    coalescing rule.
+ * @param   pClass  class (0 to EVENTSMAX - 1) of every event, indexed
+ *                  by SMF_EVENT(). Events of class SMF_CLASS_NONE are
+ *                  exempt from every rule. NULL puts each event in a
+ *                  class of its own.
  * @return  0 on success, -1 otherwise
+ * @note    The queue is read in the main loop (SMF_Run) only. An
+ *          event SMF_Run has started to take off the queue is not
+ *          overwritten by a producer in an ISR (@see qReplace), the
+ *          new event is queued behind it instead. A producer in the
+ *          main loop may be preempted by one in an ISR, exactly as
+ *          with the plain enqueue; the worst case there too is an
+ *          event queued instead of coalesced.
  */
-int SMF_putEvent(const uint8_t *pEvent);
+int SMF_setCoalesce(smf_t *pSM, smfCoalesce_t rule, const uint8_t *pClass);
+#endif /* MOS_USES(SMF_COALESCE) */
 
 /**
  * @fn      void SMF_Run(void);
  * @brief   SM Manager for the SM Framework. This must be
  *          called upon periodically. It performs the transition
- *          of the State Machine based on events from the event
- *          queue.
+ *          of the State Machines based on events from the event
+ *          queues, one event per instance per call (round-robin).
+ * @note    The timeout of the current state is armed on entry and
+ *          cancelled on exit. An expired timeout is handled ahead of
+ *          the queued events, so its resolution is the period at
+ *          which SMF_Run is called. An action returning the current
+ *          state doesn't restart the timeout.
  */
 void SMF_Run(void);
-#endif /* utils_state_machine_framework_h */
\ No newline at end of file
+
+#if MOS_USES(SMF_TRACE)
+/**
+ * @fn      int SMF_traceInit(ISMPport_t portID);
+ * @brief   Serves the transition trace on an ICS port. A frame to the
+ *          port (no arguments) copies the trace into the port response,
+ *          SMF_TRACE_RSP_LEN bytes in the trace format above (without
+ *          the magic, unused record slots zeroed), which the host then
+ *          reads. The service returns the record count.
+ * @param   portID  free ICS port, the ICS server must be initialized.
+ * @return  0 on success, -1 otherwise.
+ */
+int SMF_traceInit(ISMPport_t portID);
+
+/**
+ * @fn      void SMF_traceDump(void);
+ * @brief   Sends the transition trace over UART as one SLIP frame.
+ */
+void SMF_traceDump(void);
+#endif /* MOS_USES(SMF_TRACE) */
+#endif /* utils_state_machine_framework_h */
@@ -3,7 +3,7 @@
  * @author 	Mohit Rathod
  * Created: 28 09 2022, 02:53:01 pm
  * -----
- * Last Modified: 15 07 2024, 02:25:42 pm
+ * Last Modified: 19 10 2026, 12:38:04 am
  * Modified By  : Mohit Rathod
  * -----
  * MIT License
@@ -15,51 +15,157 @@
  */
 #include "smfdyn.h"
 #include <stdlib.h>
-#include <utils/queue.h>
+#include <string.h>
 
+/* Table representation, may be overridden for host benchmarks */
+#ifndef SMF_DYN_SPARSE
+#define SMF_DYN_SPARSE          MOS_USES(SMF_SPARSE)
+#endif
+
+#if SMF_DYN_SPARSE
+/* A transition of a state */
+typedef struct
+{
+    uint8_t event;              /* event - EVENT_0 */
+    pAction_t action;           /* eventHandler for the above event */
+} dsmEntry_t;
+
+/* Transitions of a state, sorted by event */
 typedef struct
+{
+    dsmEntry_t *pEntry;
+    uint8_t len;
+} dsmRow_t;
+
+struct dsmTable
+{
+    uint8_t stateMax;
+    uint8_t eventMax;
+    dsmRow_t row[];
+};
+#else
+struct dsmTable
 {
     uint8_t stateMax;
     uint8_t eventMax;
     pAction_t action[];
-} stateMachine_t;
+};
+#endif /* SMF_DYN_SPARSE */
 
-#define EVENT_QUEUE_LEN         (8)
+/* registered state machine instances */
+static dsmf_t *_smList[SMF_INSTANCES];
+static uint8_t _smNum;
 
-static qid_t event_qID;
-static uint8_t event_qMEM[EVENT_QUEUE_LEN];
-static state_t _smState;
-static stateMachine_t *pSM;
+static int SMF_getEvent(qid_t qID, event_t *pEvent);
+static state_t SMF_transition(const dsmf_t *pSM, event_t uEvent);
 
+int dSMF_tableInit(dsmTable_t **ppTable, uint8_t stateNUM, uint8_t evnetNUM)
+{
+    int ret = -1;
+    if ((ppTable != NULL) && (stateNUM > 0) && (evnetNUM > 0)) {
+        /* zeroed, so every (state, event) pair starts without an action */
+#if SMF_DYN_SPARSE
+        *ppTable = calloc(1, sizeof(dsmTable_t) + stateNUM * sizeof(dsmRow_t));
+#else
+        *ppTable = calloc(1, sizeof(dsmTable_t) +
+                                stateNUM * evnetNUM * sizeof(pAction_t));
+#endif
+        if (*ppTable != NULL) {
+            (*ppTable)->stateMax = stateNUM;
+            (*ppTable)->eventMax = evnetNUM;
+            ret = 0;
+        }
+    }
+    return ret;
+}
 
-static int SMF_getEvent(qid_t qID, event_t *pEvent);
-static state_t SMF_transition(state_t uState, event_t uEvent);
-
-int dSMF_init(state_t iState, uint8_t stateNUM, uint8_t evnetNUM)
-{
-    q_attr_t attr = {
-        .elen = (event_qMEM[0]),
-        .qlen = ARRAY_SIZE(event_qMEM),
-        .buffer = event_qMEM
-    };
-    /* set the intitial state of the state machine */
-    _smState = iState;
-    pSM = malloc(sizeof(stateMachine_t) + stateNUM * evnetNUM * sizeof(pAction_t));
-    pSM->stateMax = stateNUM;
-    pSM->eventMax = evnetNUM;
-    return q_init(&event_qID, &attr);
+#if SMF_DYN_SPARSE
+int dSMF_addState(dsmTable_t *pTable, state_t uState, stateTransition_t *ptr)
+{
+    int ret = -1;
+    if ((pTable != NULL) && (ptr != NULL) && (uState >= STATE_0) &&
+        (uState < (state_t)(STATE_0 + pTable->stateMax))) {
+        dsmRow_t *pRow = &(pTable->row[uState - STATE_0]);
+        dsmEntry_t *pEntry = malloc((pRow->len + ptr->len) * sizeof(dsmEntry_t));
+        if (pEntry != NULL) {
+            uint8_t num = pRow->len;
+            size_t idx;
+            /* keep the transitions added earlier for this state */
+            if (num) {
+                memcpy(pEntry, pRow->pEntry, num * sizeof(dsmEntry_t));
+            }
+            for (idx = 0; idx < ptr->len; idx++) {
+                event_t uEvent = (ptr->pAction+idx)->event;
+                if ((uEvent >= EVENT_0) &&
+                    (uEvent < (event_t)(EVENT_0 + pTable->eventMax))) {
+                    uint8_t ev = uEvent - EVENT_0;
+                    uint8_t pos = num;
+                    /* insertion sort, a repeated event replaces its action */
+                    while ((pos > 0) && (pEntry[pos - 1].event > ev)) {
+                        pos--;
+                    }
+                    if ((pos > 0) && (pEntry[pos - 1].event == ev)) {
+                        pEntry[pos - 1].action = (ptr->pAction+idx)->action;
+                        continue;
+                    }
+                    memmove(&pEntry[pos + 1], &pEntry[pos],
+                                        (num - pos) * sizeof(dsmEntry_t));
+                    pEntry[pos].event = ev;
+                    pEntry[pos].action = (ptr->pAction+idx)->action;
+                    num++;
+                }
+            }
+            free(pRow->pEntry);
+            pRow->pEntry = pEntry;
+            pRow->len = num;
+            ret = 0;
+        }
+    }
+    return ret;
 }
 
-int dSMF_addState(state_t uState, stateTransition_t *ptr)
+pAction_t dSMF_getAction(const dsmTable_t *pTable, state_t uState,
+                                                        event_t uEvent)
+{
+    const dsmRow_t *pRow = &(pTable->row[uState - STATE_0]);
+    uint8_t ev = uEvent - EVENT_0;
+    uint8_t lo = 0;
+    uint8_t hi = pRow->len;
+    /* binary search of the sorted transitions of the state */
+    while (lo < hi) {
+        uint8_t mid = (lo + hi) >> 1;
+        if (pRow->pEntry[mid].event < ev) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return ((lo < pRow->len) && (pRow->pEntry[lo].event == ev)) ?
+                                            pRow->pEntry[lo].action : NULL;
+}
+
+size_t dSMF_tableSize(const dsmTable_t *pTable)
+{
+    size_t size = sizeof(dsmTable_t) + pTable->stateMax * sizeof(dsmRow_t);
+    uint8_t idx;
+    for (idx = 0; idx < pTable->stateMax; idx++) {
+        size += pTable->row[idx].len * sizeof(dsmEntry_t);
+    }
+    return size;
+}
+#else
+int dSMF_addState(dsmTable_t *pTable, state_t uState, stateTransition_t *ptr)
 {
     int ret = -1;
-    if ((ptr != NULL) && (uState >= STATE_0) && (uState < pSM->stateMax)) {
+    if ((pTable != NULL) && (ptr != NULL) && (uState >= STATE_0) &&
+        (uState < (state_t)(STATE_0 + pTable->stateMax))) {
         int len = ptr->len;
         event_t uEvent;
         while (len--) {
             uEvent = (ptr->pAction+len)->event;
-            if ((uEvent >= EVENT_0) && (uEvent < pSM->eventMax)) {
-                pSM->action[(uState - STATE_0) * pSM->eventMax +
+            if ((uEvent >= EVENT_0) &&
+                (uEvent < (event_t)(EVENT_0 + pTable->eventMax))) {
+                pTable->action[(uState - STATE_0) * pTable->eventMax +
                             (uEvent - EVENT_0)] = (ptr->pAction+len)->action;
                }
         }
@@ -68,21 +174,66 @@ int dSMF_addState(state_t uState, stateTransition_t *ptr)
     return ret;
 }
 
-state_t dSMF_getState()
+pAction_t dSMF_getAction(const dsmTable_t *pTable, state_t uState,
+                                                        event_t uEvent)
 {
-    return _smState;
+    return pTable->action[(uState - STATE_0) * pTable->eventMax +
+                                                        (uEvent - EVENT_0)];
 }
 
-int dSMF_putEvent(const uint8_t *pEvent)
+size_t dSMF_tableSize(const dsmTable_t *pTable)
 {
-    return qEnqueue(event_qID, pEvent);
+    return sizeof(dsmTable_t) +
+            pTable->stateMax * pTable->eventMax * sizeof(pAction_t);
+}
+#endif /* SMF_DYN_SPARSE */
+
+int dSMF_init(dsmf_t *pSM, const dsmTable_t *pTable, state_t iState,
+                                                            void *pCtx)
+{
+    int ret = -1;
+    if ((pSM != NULL) && (pTable != NULL) && (_smNum < SMF_INSTANCES) &&
+        (iState >= STATE_0) && (iState < (state_t)(STATE_0 + pTable->stateMax))) {
+        q_attr_t attr = {
+            .elen = sizeof(pSM->qMEM[0]),
+            .qlen = ARRAY_SIZE(pSM->qMEM),
+            .buffer = pSM->qMEM
+        };
+        ret = q_init(&(pSM->qID), &attr);
+        if (ret == 0) {
+            pSM->pTable = pTable;
+            pSM->pCtx = pCtx;
+            /* set the intitial state of the state machine */
+            pSM->state = iState;
+            _smList[_smNum++] = pSM;
+        }
+    }
+    return ret;
+}
+
+state_t dSMF_getState(const dsmf_t *pSM)
+{
+    return pSM->state;
+}
+
+int dSMF_putEvent(dsmf_t *pSM, const uint8_t *pEvent)
+{
+    int ret = -1;
+    /* Only events known to the table are queued */
+    if ((*pEvent >= EVENT_0) && (*pEvent < (EVENT_0 + pSM->pTable->eventMax))) {
+        ret = qEnqueue(pSM->qID, pEvent);
+    }
+    return ret;
 }
 
 void dSMF_Run()
 {
+    uint8_t idx;
     event_t uEvent;
-    if (SMF_getEvent(event_qID, &uEvent) == 0) {
-        _smState = SMF_transition( _smState, uEvent);
+    for (idx = 0; idx < _smNum; idx++) {
+        if (SMF_getEvent(_smList[idx]->qID, &uEvent) == 0) {
+            _smList[idx]->state = SMF_transition(_smList[idx], uEvent);
+        }
     }
 }
 
@@ -94,11 +245,12 @@ static int SMF_getEvent(qid_t qID, event_t *pEvent)
     return ret;
 }
 
-static state_t SMF_transition(state_t uState, event_t uEvent)
+static state_t SMF_transition(const dsmf_t *pSM, event_t uEvent)
 {
-    // @todo add checks for vaild state and event variables.
-    if (pSM->action[(uState - STATE_0) * pSM->eventMax + (uEvent - EVENT_0)] != NULL) {
-        uState = pSM->action[(uState - STATE_0) * pSM->eventMax + (uEvent - EVENT_0)]();
+    state_t uState = pSM->state;
+    pAction_t action = dSMF_getAction(pSM->pTable, uState, uEvent);
+    if (action != NULL) {
+        uState = action(pSM->pCtx);
     }
     return uState;
 }
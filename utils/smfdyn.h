@@ -3,7 +3,7 @@
  * @author 	Mohit Rathod
  * Created: 28 09 2022, 02:31:57 pm
  * -----
- * Last Modified: 28 09 2022, 03:07:16 pm
+ * Last Modified: 18 10 2026, 10:52:19 am
  * Modified By  : Mohit Rathod
  * -----
  * MIT License
@@ -12,115 +12,125 @@
  * @brief   State Machine Framework(SMF) API
  *          SMF is an application agnostic framework that provides
  *          an easy way to integrate state-machine into an mOS app.
+ *          This variant allocates the transition table at run-time
+ *          to the size requested by the application. It shares the
+ *          event, state and action types with @ref smf.h
+ *          The table is either a dense (state x event) matrix, or per
+ *          state lists of transitions sorted by event and looked up by
+ *          binary search, @see MOS_CONFIG_SMF_SPARSE.
  */
-#ifndef utils_state_machine_framework_h
-#define utils_state_machine_framework_h
+#ifndef utils_state_machine_framework_dyn_h
+#define utils_state_machine_framework_dyn_h
 #include <stdint.h>
 #include <stddef.h>
 #include <mosconfig.h>
+#include <utils/queue.h>
+#include <utils/smf.h>
 
 /**
- * @brief   Event data type
- * @note    Add enumeration members when num of events
- *          is greater than 8.
+ * @brief   State Transition data structure, lists all possible event-action
+ *          pair for a particular state.
  */
-typedef enum EventEnum
+typedef struct
 {
-    EVENT_0 = 0x10,
-    EVENT_1,
-    EVENT_2,
-    EVENT_3,
-    EVENT_4,
-    EVENT_5,
-    EVENT_6,
-    EVENT_7,
-    MAX_Events
-} event_t;
+    evAction_t *pAction;    /* Pointer to evAction Array for a given state */
+    size_t len;             /* Number of valid evAction pair for the state */
+} stateTransition_t;
 
 /**
- * @brief   State data type
- * @note    Add enumeration members when num of states
- *          is greater than 8.
- */ 
-typedef enum StateEnum
+ * @brief   Dynamic transition table, allocated by @ref dSMF_tableInit.
+ */
+typedef struct dsmTable dsmTable_t;
+
+/**
+ * @brief   Dynamic state machine instance.
+ * @note    Members are private to the framework, use the dSMF_ APIs.
+ */
+typedef struct
 {
-    STATE_0 = 0x40,
-    STATE_1,
-    STATE_2,
-    STATE_3,
-    STATE_4,
-    STATE_5,
-    STATE_6,
-    STATE_7,
-    MAX_States
-} state_t;
+    const dsmTable_t *pTable;           /* transition table */
+    void *pCtx;                         /* user context for actions */
+    volatile state_t state;             /* current state */
+    qid_t qID;                          /* event queue */
+    uint8_t qMEM[SMF_EVENT_QUEUE_LEN];  /* event queue buffer */
+} dsmf_t;
 
 /**
- * @brief   EventHandler (Action) function prototype
- * 
+ * @fn      int dSMF_tableInit(dsmTable_t **, uint8_t, uint8_t);
+ * @brief   Allocate a transition table for stateNUM states and evnetNUM
+ *          events. The table may be shared by several instances.
+ * @param   ppTable     pointer to load the allocated table.
+ * @param   stateNUM    number of states (STATE_0 onwards).
+ * @param   evnetNUM    number of events (EVENT_0 onwards).
+ * @return  0 on success, -1 otherwise
  */
-typedef state_t (*pAction_t)(void);
+int dSMF_tableInit(dsmTable_t **ppTable, uint8_t stateNUM, uint8_t evnetNUM);
 
 /**
- * @brief   Event-Action data structure, lists event and its corresponding
- *          action for a given state.
+ * @fn      int dSMF_addState(dsmTable_t *, state_t, stateTransition_t *);
+ * @brief   Add a state and its transition rules to a transition table.
+ * @param   pTable  the table to add the state to.
+ * @param   uState  the state to add.
+ * @param   ptr     pointer to state transition table of the above state.
+ * @return  0 on success, -1 otherwise
  */
-typedef struct 
-{
-    event_t event;       /* event */
-    pAction_t action;    /* eventHandler for the above event */
-} evAction_t;
+int dSMF_addState(dsmTable_t *pTable, state_t uState, stateTransition_t *ptr);
 
 /**
- * @brief   State Transition data structure, lists all possible event-action
- *          pair for a particular state.
+ * @fn      pAction_t dSMF_getAction(const dsmTable_t *, state_t, event_t);
+ * @brief   Look up the action of a (state, event) pair in a table.
+ * @param   pTable  the table.
+ * @param   uState  a state of the table.
+ * @param   uEvent  an event of the table.
+ * @return  the action, NULL if the event isn't handled in the state.
  */
-typedef struct
-{
-    evAction_t *pAction;    /* Pointer to evAction Array for a given state */
-    size_t len;             /* Number of valid evAction pair for the state */
-} stateTransition_t;
+pAction_t dSMF_getAction(const dsmTable_t *pTable, state_t uState,
+                                                        event_t uEvent);
 
 /**
- * @fn      int SMF_init(state_t iState);
- * @brief   Initialize the State Machine Framework, also sets up the initial
- *          state of the generic state machine.
- * @param   iState  initial state of the state machine to be implemented.
- * @return  0 on success, -1 otherwise
+ * @fn      size_t dSMF_tableSize(const dsmTable_t *pTable);
+ * @brief   Heap memory used by a table, excluding allocator overhead.
+ * @param   pTable  the table.
+ * @return  size in bytes.
  */
-int dSMF_init(state_t iState, uint8_t stateNUM, uint8_t evnetNUM);
+size_t dSMF_tableSize(const dsmTable_t *pTable);
 
 /**
- * @fn      int SMF_addState(state_t uState, stateTransition_t *ptr);
- * @brief   Add a state and its transition rules to the SM Framework
- * @param   uState  the state to add.
- * @param   ptr     pointer to state transition table of the above state. 
+ * @fn      int dSMF_init(dsmf_t *, const dsmTable_t *, state_t, void *);
+ * @brief   Initialize a state machine instance, sets up its initial
+ *          state and registers it with the State Machine Framework.
+ * @param   pSM     instance to initialize.
+ * @param   pTable  transition table of the instance, may be shared.
+ * @param   iState  initial state of the state machine.
+ * @param   pCtx    user context passed on to the actions (may be NULL).
  * @return  0 on success, -1 otherwise
  */
-int dSMF_addState(state_t uState, stateTransition_t *ptr);
+int dSMF_init(dsmf_t *pSM, const dsmTable_t *pTable, state_t iState,
+                                                            void *pCtx);
 
 /**
- * @fn      state_t SMF_getState(void);
- * @brief   Fetches the current state of the State Machine implemented
- *          via the SM Framework.
- * @return  state 
+ * @fn      state_t dSMF_getState(const dsmf_t *pSM);
+ * @brief   Fetches the current state of a state machine instance.
+ * @param   pSM     the instance.
+ * @return  state
  */
-state_t dSMF_getState(void);
+state_t dSMF_getState(const dsmf_t *pSM);
 
 /**
- * @fn      int SMF_putEvent(const uint8_t *pEvent);
- * @brief   Add an event on the SM Framework event queue.
- * @param   pEvent Event to add
+ * @fn      int dSMF_putEvent(dsmf_t *pSM, const uint8_t *pEvent);
+ * @brief   Add an event on the event queue of an instance.
+ * @param   pSM     the instance.
+ * @param   pEvent  Event to add
  * @return  0 on success, -1 otherwise
  */
-int dSMF_putEvent(const uint8_t *pEvent);
+int dSMF_putEvent(dsmf_t *pSM, const uint8_t *pEvent);
 
 /**
- * @fn      void SMF_Run(void);
+ * @fn      void dSMF_Run(void);
  * @brief   SM Manager for the SM Framework. This must be
  *          called upon periodically. It performs the transition
- *          of the State Machine based on events from the event
- *          queue.
+ *          of the State Machines based on events from the event
+ *          queues, one event per instance per call (round-robin).
  */
 void dSMF_Run(void);
-#endif /* utils_state_machine_framework_h */
+#endif /* utils_state_machine_framework_dyn_h */